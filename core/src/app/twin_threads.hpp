@@ -8,6 +8,8 @@ namespace iodine::core {
 
     /**
      * @brief An application strategy consisting of one tick thread and one render thread.
+     *        Both threads call into the same application. Hand simulation state to the render thread through a
+     *        RenderBuffer: publish it at the end of tick() and read it in render(), without locking the world.
      */
     class IO_API TwinStrategy : public ApplicationStrategy {
         public:
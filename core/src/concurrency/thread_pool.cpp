@@ -0,0 +1,61 @@
+#include "concurrency/thread_pool.hpp"
+
+namespace iodine::core {
+    ThreadPool::ThreadPool(u32 workers) {
+        threads.reserve(workers);
+        for (u32 i = 0; i < workers; i++) {
+            threads.emplace_back("Worker #" + std::to_string(i));
+            threads.back().run([this] { work(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool() {
+        {
+            std::lock_guard lock(tasksLock);
+            stopping = true;
+        }
+        available.notify_all();
+        for (Thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::submit(std::function<void()> task) {
+        {
+            std::lock_guard lock(tasksLock);
+            tasks.push_back(std::move(task));
+        }
+        available.notify_one();
+    }
+
+    u32 ThreadPool::defaultWorkerCount() {
+        const u32 hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 1;
+    }
+
+    b8 ThreadPool::runPending() {
+        std::function<void()> task;
+        {
+            std::lock_guard lock(tasksLock);
+            if (tasks.empty()) return false;
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+        task();
+        return true;
+    }
+
+    void ThreadPool::work() {
+        while (true) {
+            std::function<void()> task;
+            {
+                std::unique_lock lock(tasksLock);
+                available.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                task = std::move(tasks.front());
+                tasks.pop_front();
+            }
+            task();
+        }
+    }
+}  // namespace iodine::core
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "concurrency/thread.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief A fixed set of worker threads consuming a shared task queue.
+     */
+    class IO_API ThreadPool {
+        public:
+        /**
+         * @brief Creates a new pool and starts its workers.
+         * @param workers The number of worker threads. Defaults to one less than the number of hardware threads.
+         */
+        explicit ThreadPool(u32 workers = defaultWorkerCount());
+        ~ThreadPool();
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool& operator=(ThreadPool&&) = delete;
+
+        /**
+         * @brief Queues a task for execution on a worker thread.
+         * @param task The task to run.
+         */
+        void submit(std::function<void()> task);
+
+        /**
+         * @brief Splits [0, count) into chunks and runs a function over them on the workers and the calling thread.
+         *        Blocks until every chunk is done. While waiting, the calling thread keeps claiming chunks and then runs
+         *        other queued tasks, so it is safe to call from inside a pool task. The first exception thrown by a chunk
+         *        is rethrown here.
+         * @tparam Function Invocable with (u64 begin, u64 end).
+         * @param count The number of elements.
+         * @param chunk The number of elements per chunk.
+         * @param function The function to run for each chunk.
+         */
+        template <typename Function>
+        void parallelFor(u64 count, u64 chunk, Function&& function) {
+            if (count == 0) return;
+            chunk = std::max<u64>(chunk, 1);
+
+            // Outlives the call, since a helper may only be dequeued after every chunk was claimed and the caller left.
+            struct State {
+                std::atomic<u64> next{0};       ///< The next chunk to claim.
+                std::atomic<u64> finished{0};   ///< The number of chunks done.
+                std::exception_ptr error;       ///< The first exception thrown by a chunk.
+                std::mutex errorLock;           ///< Protects error.
+            };
+            const u64 chunks = (count + chunk - 1) / chunk;
+            const u64 helpers = std::min<u64>(chunks - 1, threads.size());
+            std::shared_ptr<State> state = std::make_shared<State>();
+
+            // The function is only touched for claimed chunks, and the caller waits for all of them to finish.
+            auto drain = [state, chunks, chunk, count, run = &function] {
+                for (u64 c = state->next.fetch_add(1, std::memory_order_relaxed); c < chunks; c = state->next.fetch_add(1, std::memory_order_relaxed)) {
+                    try {
+                        (*run)(c * chunk, std::min(count, (c + 1) * chunk));
+                    } catch (...) {
+                        std::lock_guard lock(state->errorLock);
+                        if (!state->error) state->error = std::current_exception();
+                    }
+                    state->finished.fetch_add(1, std::memory_order_acq_rel);
+                }
+            };
+
+            for (u64 i = 0; i < helpers; i++) submit(drain);
+            drain();
+            while (state->finished.load(std::memory_order_acquire) < chunks) {
+                if (!runPending()) std::this_thread::yield();
+            }
+
+            if (state->error) std::rethrow_exception(state->error);
+        }
+
+        inline u32 getWorkerCount() const noexcept { return static_cast<u32>(threads.size()); }
+
+        /**
+         * @brief Gets the default number of workers for this machine.
+         * @return One less than the number of hardware threads, at least one.
+         */
+        static u32 defaultWorkerCount();
+
+        private:
+        std::vector<Thread> threads;                ///< The worker threads.
+        std::deque<std::function<void()>> tasks;    ///< Queued tasks.
+        std::mutex tasksLock;                       ///< Protects the task queue.
+        std::condition_variable available;          ///< Signalled when a task is queued or the pool stops.
+        b8 stopping = false;                        ///< Whether the workers should exit.
+
+        /**
+         * @brief The worker loop.
+         */
+        void work();
+
+        /**
+         * @brief Runs one queued task on the calling thread, if there is any.
+         * @return Whether a task was run.
+         */
+        b8 runPending();
+    };
+}  // namespace iodine::core
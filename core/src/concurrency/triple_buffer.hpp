@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+
+#include "prelude.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Hands values from one writer thread to one reader thread without locks.
+     *        Of the three slots, the writer owns one, the reader owns one and the third holds the latest published
+     *        value. Publishing and picking up are each a single atomic exchange of the middle slot, so neither side ever
+     *        waits and the reader always sees the latest complete value.
+     * @tparam T The value type. Slots are reused, so T should keep its capacity across writes.
+     */
+    template <typename T>
+    class IO_API TripleBuffer {
+        public:
+        TripleBuffer() = default;
+        ~TripleBuffer() = default;
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        /**
+         * @brief Gets the writer's slot. It may hold any previously published value, never one the reader is using.
+         * @return The slot to fill before publish().
+         * @warning Writer thread only.
+         */
+        inline T& getWriteBuffer() noexcept { return slots[back]; }
+
+        /**
+         * @brief Publishes the writer's slot and takes over the previous middle slot.
+         * @warning Writer thread only.
+         */
+        void publish() noexcept { back = middle.exchange(back | Fresh, std::memory_order_acq_rel) & IndexMask; }
+
+        /**
+         * @brief Picks up the latest published value, if there is a new one, and returns the reader's slot.
+         * @return The latest published value, or a default-constructed one before the first publish.
+         * @warning Reader thread only. The reference stays valid until the next call.
+         */
+        const T& read() noexcept {
+            if (middle.load(std::memory_order_relaxed) & Fresh) {
+                front = middle.exchange(front, std::memory_order_acq_rel) & IndexMask;
+            }
+            return slots[front];
+        }
+
+        /**
+         * @brief Checks whether a value was published that the reader has not picked up yet.
+         * @return True if the next read() returns a new value.
+         */
+        inline b8 hasUpdate() const noexcept { return (middle.load(std::memory_order_acquire) & Fresh) != 0; }
+
+        private:
+        static constexpr u8 IndexMask = 0x3;  ///< Middle bits holding the slot index.
+        static constexpr u8 Fresh = 0x4;      ///< Middle bit set when the middle slot has not been read yet.
+
+        T slots[3];                 ///< The three slots.
+        std::atomic<u8> middle{2};  ///< The middle slot index, plus Fresh.
+        u8 back = 0;                ///< The writer's slot.
+        u8 front = 1;               ///< The reader's slot.
+    };
+}  // namespace iodine::core
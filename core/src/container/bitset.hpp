@@ -1,5 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <bit>
+
 #include "prelude.hpp"
 
 namespace iodine::core {
@@ -65,6 +69,21 @@ namespace iodine::core {
          */
         friend BitSet operator&(BitSet left, const BitSet& right) { return left &= right; }
 
+        /**
+         * @brief Compares two bitsets bit by bit. Unset spill words are treated as zero, so capacity does not matter.
+         * @param left First bitset.
+         * @param right Other bitset.
+         * @return True if both bitsets have exactly the same bits set.
+         */
+        friend b8 operator==(const BitSet& left, const BitSet& right) noexcept {
+            const u64 words = std::max(left.totalWords(), right.totalWords());
+            for (u64 i = 0; i < words; i++) {
+                if (left.wordOrZero(i) != right.wordOrZero(i)) return false;
+            }
+            return true;
+        }
+        friend b8 operator!=(const BitSet& left, const BitSet& right) noexcept { return !(left == right); }
+
         /**
          * @brief Tests whether a specific bit is set.
          * @param bit The bit index to test.
@@ -143,19 +162,80 @@ namespace iodine::core {
         }
 
         /**
-         * @brief Checks whether this bitset intersects with another bitset.
+         * @brief Checks whether this bitset intersects with another bitset. Capacities may differ; words beyond the
+         *        shorter footprint are treated as zero.
          * @param other The other bitset to check against.
          * @return True if there is at least one bit set in both bitsets, false otherwise.
          */
         b8 intersects(const BitSet& other) const noexcept {
-            if (totalWords() != other.totalWords()) return false;
-
-            for (u64 i = 0; i < totalWords(); i++) {
+            const u64 words = std::min(totalWords(), other.totalWords());
+            for (u64 i = 0; i < words; i++) {
                 if (at(i) & other.at(i)) return true;
             }
             return false;
         }
 
+        /**
+         * @brief Checks whether every bit set in another bitset is also set in this one. Capacities may differ.
+         * @param other The other bitset to check against.
+         * @return True if this bitset is a superset of the other bitset.
+         */
+        b8 includes(const BitSet& other) const noexcept {
+            for (u64 i = 0; i < other.totalWords(); i++) {
+                if ((wordOrZero(i) & other.at(i)) != other.at(i)) return false;
+            }
+            return true;
+        }
+
+        /**
+         * @brief Checks in one pass that every bit of one bitset is set here and no bit of another is. The stack words
+         *        are tested branch-free as a single AND / AND-NOT sweep, which compilers vectorize. Capacities may differ.
+         * @param include The bits that must be set.
+         * @param exclude The bits that must not be set.
+         * @return True if this bitset includes the first bitset and does not intersect the second.
+         */
+        b8 matches(const BitSet& include, const BitSet& exclude) const noexcept {
+            Word missing = 0;
+            Word present = 0;
+            for (u64 i = 0; i < Size / WordSize; i++) {
+                missing |= include.direct[i] & ~direct[i];
+                present |= exclude.direct[i] & direct[i];
+            }
+            for (u64 i = Size / WordSize; i < include.totalWords(); i++) missing |= include.at(i) & ~wordOrZero(i);
+            for (u64 i = Size / WordSize; i < exclude.totalWords(); i++) present |= exclude.at(i) & wordOrZero(i);
+            return (missing | present) == 0;
+        }
+
+        /**
+         * @brief Computes a hash of the set bits. Bitsets that compare equal hash equally regardless of capacity.
+         * @return The hash value.
+         */
+        u64 hash() const noexcept {
+            u64 h = 0xcbf29ce484222325ull;
+            u64 words = totalWords();
+            while (words > 0 && at(words - 1) == 0) words--;
+            for (u64 i = 0; i < words; i++) {
+                h ^= static_cast<u64>(at(i)) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+            }
+            return h;
+        }
+
+        /**
+         * @brief Calls a function for every set bit, in ascending order.
+         * @tparam Function The function type, invocable with a u64 bit index.
+         * @param function The function to call.
+         */
+        template <typename Function>
+        void forEach(Function&& function) const {
+            for (u64 i = 0; i < totalWords(); i++) {
+                Word word = at(i);
+                while (word) {
+                    function(i * WordSize + std::countr_zero(word));
+                    word &= word - 1;
+                }
+            }
+        }
+
         private:
         std::array<Word, Size / WordSize> direct{};  ///< Stack storage for the first Size bits.
         std::vector<Word> spill;                     ///< Dynamic storage for bits beyond Size.
@@ -174,6 +254,10 @@ namespace iodine::core {
          * @brief Returns a reference to the storage word at index.
          */
         const Word& at(Word index) const noexcept { return index < Size / WordSize ? direct[index] : spill[index - Size / WordSize]; }
+        /**
+         * @brief Returns the storage word at index, or zero if it lies beyond the current footprint.
+         */
+        Word wordOrZero(u64 index) const noexcept { return index < totalWords() ? at(index) : 0; }
 
         /**
          * @brief Locates the underlying 64‑bit word that contains a given bit (mutable).
@@ -212,4 +296,11 @@ namespace iodine::core {
             value ? (*w |= 1ull << (bit & (WordSize - 1))) : (*w &= ~(1ull << (bit & (WordSize - 1))));
         }
     };
-}  // namespace iodine::core
\ No newline at end of file
+}  // namespace iodine::core
+
+namespace std {
+    template <typename Word, iodine::u64 Size>
+    struct hash<iodine::core::BitSet<Word, Size>> {
+        std::size_t operator()(const iodine::core::BitSet<Word, Size>& bits) const noexcept { return static_cast<std::size_t>(bits.hash()); }
+    };
+}  // namespace std
\ No newline at end of file
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <bit>
+#include <cstring>
+#include <iterator>
+#include <new>
+#include <span>
+#include <vector>
+
+#include "prelude.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief A growable array stored in fixed-size, 64-byte-aligned chunks instead of one contiguous buffer.
+     *        Growing allocates a new chunk and never relocates existing elements, so references stay valid across
+     *        push_back and a spike of insertions costs no bulk copy. Each chunk holds a power-of-two number of elements,
+     *        so indexing is a shift and a mask, and every chunk can be handed to a worker thread as one aligned block.
+     *        Chunks are kept when elements are popped and reused on the next growth.
+     * @tparam T The element type.
+     * @tparam ChunkBytes The target chunk size in bytes. Chunks hold as many elements as fit, rounded down to a power
+     *                    of two, and at least one.
+     */
+    template <typename T, u64 ChunkBytes = 16384>
+    class IO_API ChunkedVector {
+        public:
+        static constexpr u64 Alignment = std::max<u64>(64, alignof(T));                                   ///< Alignment of every chunk.
+        static constexpr u64 ChunkCapacity = std::bit_floor(std::max<u64>(1, ChunkBytes / sizeof(T)));  ///< Elements per chunk.
+
+        /**
+         * @brief Random-access iterator over the elements, in index order.
+         */
+        template <typename Value>
+        class BasicIterator {
+            public:
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = std::remove_const_t<Value>;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Value*;
+            using reference = Value&;
+
+            BasicIterator() = default;
+            BasicIterator(Value* const* chunks, u64 index) : chunks(chunks), index(index) {}
+
+            inline reference operator*() const noexcept { return chunks[index / ChunkCapacity][index % ChunkCapacity]; }
+            inline pointer operator->() const noexcept { return &**this; }
+            inline reference operator[](difference_type offset) const noexcept { return *(*this + offset); }
+
+            inline BasicIterator& operator++() noexcept {
+                index++;
+                return *this;
+            }
+            inline BasicIterator operator++(int) noexcept {
+                BasicIterator copy = *this;
+                index++;
+                return copy;
+            }
+            inline BasicIterator& operator--() noexcept {
+                index--;
+                return *this;
+            }
+            inline BasicIterator operator--(int) noexcept {
+                BasicIterator copy = *this;
+                index--;
+                return copy;
+            }
+            inline BasicIterator& operator+=(difference_type offset) noexcept {
+                index += offset;
+                return *this;
+            }
+            inline BasicIterator& operator-=(difference_type offset) noexcept {
+                index -= offset;
+                return *this;
+            }
+            inline BasicIterator operator+(difference_type offset) const noexcept { return BasicIterator(chunks, index + offset); }
+            inline BasicIterator operator-(difference_type offset) const noexcept { return BasicIterator(chunks, index - offset); }
+            friend inline BasicIterator operator+(difference_type offset, const BasicIterator& it) noexcept { return it + offset; }
+            inline difference_type operator-(const BasicIterator& other) const noexcept {
+                return static_cast<difference_type>(index) - static_cast<difference_type>(other.index);
+            }
+
+            inline auto operator<=>(const BasicIterator& other) const noexcept { return index <=> other.index; }
+            inline bool operator==(const BasicIterator& other) const noexcept { return index == other.index; }
+
+            private:
+            Value* const* chunks = nullptr;  ///< The chunk table of the vector.
+            u64 index = 0;                   ///< The element index.
+        };
+
+        using iterator = BasicIterator<T>;
+        using const_iterator = BasicIterator<const T>;
+
+        ChunkedVector() = default;
+        ~ChunkedVector() {
+            clear();
+            release();
+        }
+        ChunkedVector(const ChunkedVector& other) { *this = other; }
+        ChunkedVector(ChunkedVector&& other) noexcept : chunks(std::move(other.chunks)), count(other.count) { other.count = 0; }
+
+        /**
+         * @brief Replaces the elements with copies of another vector's, reusing the chunks already allocated.
+         *        Trivially copyable elements are copied chunk by chunk in bulk.
+         */
+        ChunkedVector& operator=(const ChunkedVector& other) {
+            if (this == &other) return *this;
+            clear();
+            reserve(other.count);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                for (u64 first = 0; first < other.count; first += ChunkCapacity) {
+                    std::memcpy(chunks[first / ChunkCapacity], other.chunks[first / ChunkCapacity], std::min(ChunkCapacity, other.count - first) * sizeof(T));
+                }
+                count = other.count;
+            } else {
+                for (u64 index = 0; index < other.count; index++) push_back(other[index]);
+            }
+            return *this;
+        }
+
+        ChunkedVector& operator=(ChunkedVector&& other) noexcept {
+            if (this != &other) {
+                clear();
+                release();
+                chunks = std::move(other.chunks);
+                count = other.count;
+                other.chunks.clear();
+                other.count = 0;
+            }
+            return *this;
+        }
+
+        inline void push_back(const T& value) {
+            new (slot()) T(value);
+            count++;
+        }
+        inline void push_back(T&& value) {
+            new (slot()) T(std::move(value));
+            count++;
+        }
+
+        template <typename... Args>
+        inline T& emplace_back(Args&&... args) {
+            T* element = new (slot()) T(std::forward<Args>(args)...);
+            count++;
+            return *element;
+        }
+
+        inline void pop_back() noexcept {
+            count--;
+            (*this)[count].~T();
+        }
+
+        /**
+         * @brief Grows or shrinks to a number of elements, value-initializing new ones.
+         * @param size The new number of elements.
+         */
+        void resize(u64 size) {
+            while (count > size) pop_back();
+            reserve(size);
+            while (count < size) emplace_back();
+        }
+
+        /**
+         * @brief Allocates chunks up front for a total number of elements. Existing elements never move.
+         * @param capacity The number of elements to make room for.
+         */
+        void reserve(u64 capacity) {
+            while (chunks.size() * ChunkCapacity < capacity) {
+                chunks.push_back(static_cast<T*>(::operator new(ChunkCapacity * sizeof(T), std::align_val_t{Alignment})));
+            }
+        }
+
+        /**
+         * @brief Destroys every element. Chunks are kept for reuse.
+         */
+        void clear() noexcept {
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                for (u64 index = 0; index < count; index++) (*this)[index].~T();
+            }
+            count = 0;
+        }
+
+        inline T& operator[](u64 index) noexcept { return chunks[index / ChunkCapacity][index % ChunkCapacity]; }
+        inline const T& operator[](u64 index) const noexcept { return chunks[index / ChunkCapacity][index % ChunkCapacity]; }
+
+        inline u64 size() const noexcept { return count; }
+        inline u64 capacity() const noexcept { return chunks.size() * ChunkCapacity; }
+
+        /**
+         * @brief Gets the number of chunks that hold elements.
+         * @return The number of chunks, the last of which may be partially filled.
+         */
+        inline u64 getChunkCount() const noexcept { return (count + ChunkCapacity - 1) / ChunkCapacity; }
+
+        /**
+         * @brief Gets the elements of a chunk as one aligned, contiguous block.
+         * @param chunk The chunk, must be smaller than getChunkCount().
+         * @return The elements the chunk holds.
+         */
+        inline std::span<T> getChunk(u64 chunk) noexcept { return {chunks[chunk], std::min(ChunkCapacity, count - chunk * ChunkCapacity)}; }
+        inline std::span<const T> getChunk(u64 chunk) const noexcept { return {chunks[chunk], std::min(ChunkCapacity, count - chunk * ChunkCapacity)}; }
+
+        inline iterator begin() noexcept { return iterator(chunks.data(), 0); }
+        inline iterator end() noexcept { return iterator(chunks.data(), count); }
+        inline const_iterator begin() const noexcept { return const_iterator(chunks.data(), 0); }
+        inline const_iterator end() const noexcept { return const_iterator(chunks.data(), count); }
+
+        private:
+        std::vector<T*> chunks;  ///< Every allocated chunk, filled in order. Allocated with Alignment.
+        u64 count = 0;           ///< The number of elements.
+
+        /**
+         * @brief Frees every chunk. Elements must have been destroyed.
+         */
+        void release() noexcept {
+            for (T* chunk : chunks) ::operator delete(chunk, std::align_val_t{Alignment});
+            chunks.clear();
+        }
+
+        /**
+         * @brief Gets uninitialized memory for the next element, allocating a chunk if the last one is full.
+         */
+        inline T* slot() {
+            reserve(count + 1);
+            return chunks[count / ChunkCapacity] + count % ChunkCapacity;
+        }
+    };
+}  // namespace iodine::core
@@ -1,16 +1,74 @@
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+#include <cstring>
+#include <limits>
+#include <new>
+#include <span>
+
+#include "container/chunked_vector.hpp"
 #include "debug/exception.hpp"
 
 namespace iodine::core {
+    /**
+     * @brief Stands in for the data vector of a sparse set of empty values. Only the element count exists; every
+     *        element aliases one shared instance, so a set of tags costs its index arrays and nothing else.
+     * @tparam T The empty value type.
+     */
     template <typename T>
+    class IO_API EmptyStorage {
+        STATIC_ASSERT(std::is_empty_v<T>, "EmptyStorage only holds empty types");
+
+        public:
+        inline void push_back(const T&) noexcept { count++; }
+        template <typename... Args>
+        inline void emplace_back(Args&&...) noexcept {
+            count++;
+        }
+        inline void pop_back() noexcept { count--; }
+        inline void reserve(u64) noexcept {}
+        inline T& operator[](u64) noexcept { return value; }
+        inline const T& operator[](u64) const noexcept { return value; }
+        inline T* data() noexcept { return &value; }
+
+        private:
+        [[no_unique_address]] T value{};  ///< The instance every element aliases.
+        u64 count = 0;                    ///< The number of elements.
+    };
+
+    /**
+     * @brief Maps sparse u64 indices to densely packed values.
+     *        The sparse side is paged: fixed-size pages of 32-bit dense positions are allocated lazily, so memory scales
+     *        with the populated index ranges rather than with the highest index.
+     *        Empty value types (tags) keep no data array at all, see EmptyStorage.
+     * @tparam T The value type.
+     * @tparam Chunked Whether values are stored in fixed-size aligned chunks (see ChunkedVector) instead of one
+     *                 contiguous array. Chunked sets never relocate values as they grow, but only expose their data
+     *                 chunk by chunk.
+     */
+    template <typename T, b8 Chunked = false>
     class IO_API SparseSet {
+        using Data = std::conditional_t<std::is_empty_v<T>, EmptyStorage<T>, std::conditional_t<Chunked, ChunkedVector<T>, std::vector<T>>>;
+
         public:
+        static constexpr u64 PageSize = 4096;                                                                       ///< Number of sparse entries per page (16 KiB).
+        static constexpr u32 Absent = std::numeric_limits<u32>::max();                                              ///< Marks an unused sparse entry.
+        static constexpr u64 ChunkCapacity = Chunked && !std::is_empty_v<T> ? ChunkedVector<T>::ChunkCapacity : 0;  ///< Values per chunk, 0 if contiguous.
+
         SparseSet() : size(0) {};
         ~SparseSet() = default;
-        SparseSet(const SparseSet& other) = default;
+        SparseSet(const SparseSet& other) : dense(other.dense), data(other.data), size(other.size) { copyPages(other); }
         SparseSet(SparseSet&& other) = default;
-        SparseSet& operator=(const SparseSet& other) = default;
+        SparseSet& operator=(const SparseSet& other) {
+            if (this != &other) {
+                dense = other.dense;
+                data = other.data;
+                size = other.size;
+                copyPages(other);
+            }
+            return *this;
+        }
         SparseSet& operator=(SparseSet&& other) = default;
 
         /**
@@ -22,14 +80,7 @@ namespace iodine::core {
             if (contains(index)) {
                 return;
             }
-            if (index >= sparse.size()) {
-                sparse.resize(index + 1, 0);
-            }
-            if (size >= dense.size()) {
-                dense.resize(size + 1, 0);
-            }
-            dense[size] = index;
-            sparse[index] = size;
+            link(index);
             data.push_back(value);
             size++;
         }
@@ -43,14 +94,7 @@ namespace iodine::core {
             if (contains(index)) {
                 return;
             }
-            if (index >= sparse.size()) {
-                sparse.resize(index + 1, 0);
-            }
-            if (size >= dense.size()) {
-                dense.resize(size + 1, 0);
-            }
-            dense[size] = index;
-            sparse[index] = size;
+            link(index);
             data.emplace_back(std::move(value));
             size++;
         }
@@ -66,18 +110,62 @@ namespace iodine::core {
             if (contains(index)) {
                 return;
             }
-            if (index >= sparse.size()) {
-                sparse.resize(index + 1, 0);
-            }
-            if (size >= dense.size()) {
-                dense.resize(size + 1, 0);
-            }
-            dense[size] = index;
-            sparse[index] = size;
+            link(index);
             data.emplace_back(std::forward<Args>(args)...);
             size++;
         }
 
+        /**
+         * @brief Reserves room for additional values in the dense arrays.
+         * @param count The number of values about to be inserted.
+         */
+        void reserve(u64 count) {
+            dense.reserve(size + count);
+            data.reserve(size + count);
+        }
+
+        /**
+         * @brief Appends values for several new indices at once, copying them bytewise in one block.
+         * @param indices The indices, none of which may be contained yet.
+         * @param values The values in the same order, tightly packed and possibly unaligned. Ignored for empty types.
+         */
+        void insertBatch(std::span<const u64> indices, const void* values)
+            requires(std::is_trivially_copyable_v<T>)
+        {
+            reserve(indices.size());
+            for (const u64 index : indices) {
+                IO_ASSERT_MSG(!contains(index), "Index is already contained");
+                link(index);
+                size++;
+            }
+            if constexpr (std::is_empty_v<T>) {
+                for (u64 i = 0; i < indices.size(); i++) data.emplace_back();
+            } else if constexpr (!std::default_initializable<T>) {
+                // Nothing to grow into, so each value is copied through an aligned buffer.
+                const byte* source = static_cast<const byte*>(values);
+                for (u64 i = 0; i < indices.size(); i++) {
+                    alignas(T) byte buffer[sizeof(T)];
+                    std::memcpy(buffer, source + i * sizeof(T), sizeof(T));
+                    data.push_back(*std::launder(reinterpret_cast<T*>(buffer)));
+                }
+            } else {
+                const u64 first = data.size();
+                data.resize(first + indices.size());
+                if constexpr (Chunked) {
+                    // Copy run by run, each run ending at a chunk boundary.
+                    const byte* source = static_cast<const byte*>(values);
+                    for (u64 copied = 0; copied < indices.size();) {
+                        const u64 position = first + copied;
+                        const u64 run = std::min(indices.size() - copied, ChunkCapacity - position % ChunkCapacity);
+                        std::memcpy(&data[position], source + copied * sizeof(T), run * sizeof(T));
+                        copied += run;
+                    }
+                } else if (!indices.empty()) {
+                    std::memcpy(data.data() + first, values, indices.size() * sizeof(T));
+                }
+            }
+        }
+
         /**
          * @brief Removes an element from the sparse set.
          * @param index The index of the element to remove.
@@ -86,9 +174,12 @@ namespace iodine::core {
             if (!contains(index)) {
                 return;
             }
-            sparse[dense[size - 1]] = sparse[index];
-            std::swap(dense[sparse[index]], dense[size - 1]);
-            std::swap(data[sparse[index]], data[size - 1]);
+            u32& erased = entry(index);
+            const u32 position = erased;
+            entry(dense[size - 1]) = position;
+            erased = Absent;
+            std::swap(dense[position], dense[size - 1]);
+            std::swap(data[position], data[size - 1]);
             dense.pop_back();
             data.pop_back();
             size--;
@@ -103,12 +194,80 @@ namespace iodine::core {
             if (index1 == index2 || !contains(index1) || !contains(index2)) {
                 return;
             }
-            u64 pos1 = sparse[index1];
-            u64 pos2 = sparse[index2];
+            u32& pos1 = entry(index1);
+            u32& pos2 = entry(index2);
 
             std::swap(dense[pos1], dense[pos2]);
-            std::swap(sparse[index1], sparse[index2]);
             std::swap(data[pos1], data[pos2]);
+            std::swap(pos1, pos2);
+        }
+
+        /**
+         * @brief Sorts the values in place, reordering dense, sparse and data arrays together.
+         * @tparam Compare A strict weak ordering invocable with (const T&, const T&).
+         * @tparam Swapped Invocable with two dense positions, called after they were swapped.
+         * @param compare The ordering.
+         * @param swapped Lets owners mirror the reordering in parallel arrays.
+         */
+        template <typename Compare, typename Swapped>
+        void sort(Compare compare, Swapped swapped) {
+            std::vector<u64> order(size);
+            for (u64 position = 0; position < size; position++) order[position] = position;
+            std::sort(order.begin(), order.end(), [&](u64 left, u64 right) { return compare(data[left], data[right]); });
+
+            // Apply the permutation cycle by cycle: position i receives the value that was at order[i].
+            for (u64 position = 0; position < size; position++) {
+                u64 current = position;
+                u64 next = order[current];
+                while (next != position) {
+                    swapAt(current, next);
+                    swapped(current, next);
+                    order[current] = current;
+                    current = next;
+                    next = order[current];
+                }
+                order[current] = current;
+            }
+        }
+
+        template <typename Compare>
+        void sort(Compare compare) {
+            sort(compare, [](u64, u64) {});
+        }
+
+        /**
+         * @brief Sorts the values with an insertion sort. Runs in O(n + inversions), so keeping mostly sorted data sorted
+         *        every tick is cheap.
+         * @tparam Compare A strict weak ordering invocable with (const T&, const T&).
+         * @tparam Swapped Invocable with two dense positions, called after they were swapped.
+         * @param compare The ordering.
+         * @param swapped Lets owners mirror the reordering in parallel arrays.
+         */
+        template <typename Compare, typename Swapped>
+        void sortIncremental(Compare compare, Swapped swapped) {
+            for (u64 position = 1; position < size; position++) {
+                for (u64 current = position; current > 0 && compare(data[current], data[current - 1]); current--) {
+                    swapAt(current - 1, current);
+                    swapped(current - 1, current);
+                }
+            }
+        }
+
+        template <typename Compare>
+        void sortIncremental(Compare compare) {
+            sortIncremental(compare, [](u64, u64) {});
+        }
+
+        /**
+         * @brief Swaps the values at two dense positions, keeping the sparse side in sync.
+         * @param position1 The first dense position, must be smaller than getSize().
+         * @param position2 The second dense position, must be smaller than getSize().
+         */
+        void swapAt(u64 position1, u64 position2) {
+            if (position1 == position2) return;
+            std::swap(entry(dense[position1]), entry(dense[position2]));
+            std::swap(dense[position1], dense[position2]);
+            std::swap(data[position1], data[position2]);
         }
 
         /**
@@ -116,20 +275,48 @@ namespace iodine::core {
          * @return A pair containing a pointer to the data and the size of the sparse set.
          * @warning The data pointer is only valid as long as the sparse set's size does not change.
          */
-        std::pair<T*, u64> getData() { return {data.data(), size}; }
+        std::pair<T*, u64> getData()
+            requires(!Chunked)
+        {
+            return {data.data(), size};
+        }
+        std::pair<const T*, u64> getData() const
+            requires(!Chunked)
+        {
+            return {data.data(), size};
+        }
+
+        /**
+         * @brief Calls a function for every contiguous block of values, in dense order: the whole array, or each chunk.
+         * @tparam Function Invocable with (const T* first, u64 count).
+         * @param function The function to call.
+         */
+        template <typename Function>
+        void forEachBlock(Function&& function) const
+            requires(!std::is_empty_v<T>)
+        {
+            if constexpr (Chunked) {
+                for (u64 chunk = 0; chunk < data.getChunkCount(); chunk++) {
+                    const std::span<const T> values = data.getChunk(chunk);
+                    function(values.data(), static_cast<u64>(values.size()));
+                }
+            } else if (size > 0) {
+                function(data.data(), size);
+            }
+        }
 
         const T& operator[](u64 index) const {
             if (!contains(index)) {
                 THROW_CORE_EXCEPTION(Exception::Type::NotFound, "Sparse set does not contain value at index");
             }
-            return data[sparse[index]];
+            return data[entry(index)];
         }
 
         T& operator[](u64 index) {
             if (!contains(index)) {
                 THROW_CORE_EXCEPTION(Exception::Type::NotFound, "Sparse set does not contain value at index");
             }
-            return data[sparse[index]];
+            return data[entry(index)];
         }
 
         /**
@@ -141,7 +328,7 @@ namespace iodine::core {
             if (!contains(index)) {
                 THROW_CORE_EXCEPTION(Exception::Type::NotFound, "Sparse set does not contain value at index");
             }
-            return data[sparse[index]];
+            return data[entry(index)];
         }
 
         /**
@@ -153,30 +340,144 @@ namespace iodine::core {
             if (!contains(index)) {
                 THROW_CORE_EXCEPTION(Exception::Type::NotFound, "Sparse set does not contain value at index");
             }
-            return data[sparse[index]];
+            return data[entry(index)];
         }
 
+        /**
+         * @brief Looks up the value at the given index without throwing.
+         * @param index The index to look up.
+         * @return A pointer to the value, or nullptr if the sparse set does not contain the index.
+         */
+        inline T* find(u64 index) noexcept {
+            const u32* position = lookup(index);
+            return position ? &data[*position] : nullptr;
+        }
+        inline const T* find(u64 index) const noexcept {
+            const u32* position = lookup(index);
+            return position ? &data[*position] : nullptr;
+        }
+
+        /**
+         * @brief Gets the value stored at a dense position, without any checks.
+         * @param position The dense position, must be smaller than getSize().
+         * @return The value at the dense position.
+         */
+        inline T& getAt(u64 position) noexcept { return data[position]; }
+        inline const T& getAt(u64 position) const noexcept { return data[position]; }
+
+        /**
+         * @brief Gets the dense position of the value at the given index, without any checks.
+         * @param index The index, must be contained in the sparse set.
+         * @return The dense position.
+         */
+        inline u64 getPosition(u64 index) const noexcept { return entry(index); }
+
+        /**
+         * @brief Fetches the sparse indices in dense order, i.e. getIndices()[i] is the index of the i-th value.
+         * @return A pointer to the first index. There are getSize() indices.
+         * @warning The pointer is only valid as long as the sparse set's size does not change.
+         */
+        inline const u64* getIndices() const noexcept { return dense.data(); }
+
         /**
          * @brief Checks if the sparse set contains a value at the given index.
          * @param index The index to check.
          * @return True if the sparse set contains a value at the given index, false otherwise.
          */
-        inline b8 contains(u64 index) const noexcept { return index < sparse.size() && sparse[index] < size && dense[sparse[index]] == index; }
+        inline b8 contains(u64 index) const noexcept { return lookup(index) != nullptr; }
 
         inline u64 getSize() const noexcept { return size; }
 
         /* Non-const iterator interfaces */
-        inline std::vector<T>::iterator begin() { return data.begin(); }
-        inline std::vector<T>::iterator end() { return data.begin() + size; }
+        inline auto begin()
+            requires(!std::is_empty_v<T>)
+        {
+            return data.begin();
+        }
+        inline auto end()
+            requires(!std::is_empty_v<T>)
+        {
+            return data.begin() + size;
+        }
 
         /* Const iterator interfaces */
-        inline std::vector<T>::const_iterator begin() const { return data.begin(); }
-        inline std::vector<T>::const_iterator end() const { return data.begin() + size; }
+        inline auto begin() const
+            requires(!std::is_empty_v<T>)
+        {
+            return data.begin();
+        }
+        inline auto end() const
+            requires(!std::is_empty_v<T>)
+        {
+            return data.begin() + size;
+        }
+
+        /**
+         * @brief Counts the sparse pages currently allocated.
+         * @return The number of allocated pages.
+         */
+        u64 getPageCount() const noexcept {
+            return static_cast<u64>(std::count_if(sparse.begin(), sparse.end(), [](const Unique<u32[]>& page) { return page != nullptr; }));
+        }
 
         private:
-        std::vector<u64> dense;   ///< Maps dense index to sparse index
-        std::vector<u64> sparse;  ///< Maps sparse index to dense index
-        std::vector<T> data;      ///< Data storage
-        u64 size;                 ///< Number of elements in the sparse set
+        std::vector<u64> dense;             ///< Maps dense index to sparse index
+        std::vector<Unique<u32[]>> sparse;  ///< Pages mapping sparse index to dense position, allocated on first use
+        Data data;                          ///< Data storage
+        u64 size;                           ///< Number of elements in the sparse set
+
+        /**
+         * @brief Finds the dense position of an index.
+         * @param index The sparse index.
+         * @return A pointer to the dense position, or nullptr if the index is not contained.
+         */
+        inline const u32* lookup(u64 index) const noexcept {
+            const u64 page = index / PageSize;
+            if (page >= sparse.size() || !sparse[page]) return nullptr;
+            const u32* position = &sparse[page][index % PageSize];
+            return *position == Absent ? nullptr : position;
+        }
+
+        /**
+         * @brief Gets the sparse entry of an index whose page exists, without any checks.
+         */
+        inline u32& entry(u64 index) const noexcept { return sparse[index / PageSize][index % PageSize]; }
+
+        /**
+         * @brief Points a new index at the next dense position, allocating its page if needed.
+         * @param index The sparse index, must not be contained yet.
+         */
+        void link(u64 index) {
+            IO_ASSERT_MSG(size < Absent, "Sparse set is full");
+            const u64 page = index / PageSize;
+            if (page >= sparse.size()) {
+                sparse.resize(page + 1);
+            }
+            if (!sparse[page]) {
+                sparse[page] = MakeUnique<u32[]>(PageSize);
+                std::fill_n(sparse[page].get(), PageSize, Absent);
+            }
+            if (size >= dense.size()) {
+                dense.resize(size + 1, 0);
+            }
+            dense[size] = index;
+            sparse[page][index % PageSize] = static_cast<u32>(size);
+        }
+
+        /**
+         * @brief Deep-copies the sparse pages of another set, reusing the pages already allocated here.
+         */
+        void copyPages(const SparseSet& other) {
+            sparse.resize(std::max(sparse.size(), other.sparse.size()));
+            for (u64 page = 0; page < sparse.size(); page++) {
+                const u32* source = page < other.sparse.size() ? other.sparse[page].get() : nullptr;
+                if (!source) {
+                    if (sparse[page]) std::fill_n(sparse[page].get(), PageSize, Absent);
+                    continue;
+                }
+                if (!sparse[page]) sparse[page] = MakeUnique<u32[]>(PageSize);
+                std::copy_n(source, PageSize, sparse[page].get());
+            }
+        }
     };
 }  // namespace iodine::core
\ No newline at end of file
@@ -134,12 +134,43 @@ namespace iodine::core {
         }
     }
 
+    void Metrics::registerTiming(const std::string& label, f64 seconds) {
+        std::lock_guard<std::mutex> lock(timingsMutex);
+        Timing& timing = timings[label];
+        timing.min = timing.count == 0 ? seconds : std::min(timing.min, seconds);
+        timing.max = timing.count == 0 ? seconds : std::max(timing.max, seconds);
+        timing.total += seconds;
+        timing.count++;
+    }
+
+    Metrics::Timing Metrics::getTiming(const std::string& label) const {
+        std::lock_guard<std::mutex> lock(timingsMutex);
+        auto it = timings.find(label);
+        if (it == timings.end()) {
+            THROW_CORE_EXCEPTION(Exception::Type::NotFound, "Timed section not registered");
+        }
+        return it->second;
+    }
+
+    void Metrics::resetTimings() {
+        std::lock_guard<std::mutex> lock(timingsMutex);
+        timings.clear();
+    }
+
     void Metrics::report() const {
         IO_INFO("Memory metrics:");
         for (const auto& [thread, metrics] : threadMetrics) {
             IO_INFO(getMemoryMetrics(thread).c_str());
         }
         IO_INFO(getGlobalMemoryMetrics().c_str());
+
+        std::lock_guard<std::mutex> lock(timingsMutex);
+        if (timings.empty()) return;
+        IO_INFO("Timing metrics:");
+        for (const auto& [label, timing] : timings) {
+            IO_INFO("\"%s\": %llu samples, avg %.3f us, min %.3f us, max %.3f us", label.c_str(), timing.count, timing.getAverage() * 1e6, timing.min * 1e6,
+                    timing.max * 1e6);
+        }
     }
 
     std::string Metrics::getMemoryMetrics(const UUID& thread) const {
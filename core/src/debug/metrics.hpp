@@ -48,6 +48,38 @@ namespace iodine::core {
          */
         void registerDeallocation(void* ptr);
 
+        /**
+         * @brief Accumulated samples of a timed section.
+         */
+        struct Timing {
+            u64 count = 0;    ///< The number of samples.
+            f64 total = 0.0;  ///< The sum of every sample (in seconds).
+            f64 min = 0.0;    ///< The shortest sample (in seconds).
+            f64 max = 0.0;    ///< The longest sample (in seconds).
+
+            inline f64 getAverage() const noexcept { return count ? total / count : 0.0; }
+        };
+
+        /**
+         * @brief Registers one sample of a timed section.
+         * @param label The name of the timed section.
+         * @param seconds The duration of the sample (in seconds).
+         * @note This function is thread-safe.
+         */
+        void registerTiming(const std::string& label, f64 seconds);
+
+        /**
+         * @brief Gets the accumulated samples of a timed section.
+         * @param label The name of the timed section.
+         * @return The accumulated samples.
+         */
+        Timing getTiming(const std::string& label) const;
+
+        /**
+         * @brief Clears the samples of every timed section.
+         */
+        void resetTimings();
+
         /**
          * @brief Logs the current metrics for all threads.
          */
@@ -225,6 +257,8 @@ namespace iodine::core {
         };
 
         mutable std::mutex registrarMutex;                       ///< Protects allocations and the counters from concurrent access.
+        mutable std::mutex timingsMutex;                         ///< Protects the timed sections from concurrent access.
+        std::unordered_map<std::string, Timing> timings;         ///< Samples of every timed section.
         std::unordered_map<UUID, ThreadMetrics*> threadMetrics;  ///< The metrics for each thread.
     };
 }  // namespace iodine::core
\ No newline at end of file
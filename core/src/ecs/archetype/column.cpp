@@ -0,0 +1,75 @@
+#include "ecs/archetype/column.hpp"
+
+#include <new>
+#include <utility>
+
+namespace iodine::core {
+    namespace Archetype {
+        Column::Column(const Component::Info& info) : info(info), data(nullptr), size(0), capacity(0) {}
+
+        Column::~Column() {
+            for (u64 i = 0; i < size; i++) {
+                info.destroy(at(i));
+            }
+            if (data) {
+                ::operator delete(data, std::align_val_t(info.alignment));
+            }
+        }
+
+        Column::Column(Column&& other) noexcept : info(other.info), data(other.data), size(other.size), capacity(other.capacity) {
+            other.data = nullptr;
+            other.size = 0;
+            other.capacity = 0;
+        }
+
+        Column& Column::operator=(Column&& other) noexcept {
+            if (this != &other) {
+                for (u64 i = 0; i < size; i++) {
+                    info.destroy(at(i));
+                }
+                if (data) {
+                    ::operator delete(data, std::align_val_t(info.alignment));
+                }
+                info = other.info;
+                data = std::exchange(other.data, nullptr);
+                size = std::exchange(other.size, 0);
+                capacity = std::exchange(other.capacity, 0);
+            }
+            return *this;
+        }
+
+        void* Column::emplaceBack() {
+            if (size == capacity) {
+                grow(capacity == 0 ? 8 : capacity * 2);
+            }
+            return at(size++);
+        }
+
+        void Column::swapRemove(u64 row) {
+            IO_ASSERT_MSG(row < size, "Column row out of bounds");
+            info.destroy(at(row));
+            if (row != size - 1) {
+                info.move(at(row), at(size - 1));
+                info.destroy(at(size - 1));
+            }
+            size--;
+        }
+
+        void Column::reserve(u64 count) {
+            if (count > capacity) grow(count);
+        }
+
+        void Column::grow(u64 count) {
+            byte* fresh = static_cast<byte*>(::operator new(count * info.size, std::align_val_t(info.alignment)));
+            for (u64 i = 0; i < size; i++) {
+                info.move(fresh + i * info.size, at(i));
+                info.destroy(at(i));
+            }
+            if (data) {
+                ::operator delete(data, std::align_val_t(info.alignment));
+            }
+            data = fresh;
+            capacity = count;
+        }
+    }  // namespace Archetype
+}  // namespace iodine::core
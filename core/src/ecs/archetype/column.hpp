@@ -0,0 +1,77 @@
+#pragma once
+
+#include "ecs/component/storage.hpp"
+
+namespace iodine::core {
+    namespace Archetype {
+        /**
+         * @brief A type-erased, contiguous array of a single component type. One column per component in an archetype table.
+         */
+        class IO_API Column {
+            public:
+            explicit Column(const Component::Info& info);
+            ~Column();
+            Column(const Column& other) = delete;
+            Column(Column&& other) noexcept;
+            Column& operator=(const Column& other) = delete;
+            Column& operator=(Column&& other) noexcept;
+
+            /**
+             * @brief Makes room for one more element at the back of the column.
+             * @return A pointer to the uninitialized slot. The caller must construct a component in it.
+             */
+            void* emplaceBack();
+
+            /**
+             * @brief Destroys the element at the given row and fills the hole with the last element.
+             * @param row The row to remove.
+             */
+            void swapRemove(u64 row);
+
+            /**
+             * @brief Ensures the column can hold at least the given number of elements without reallocating.
+             * @param count The number of elements.
+             */
+            void reserve(u64 count);
+
+            /**
+             * @brief Gets a pointer to the element at the given row.
+             * @param row The row to fetch.
+             * @return A pointer to the element.
+             */
+            inline void* at(u64 row) noexcept { return data + row * info.size; }
+            inline const void* at(u64 row) const noexcept { return data + row * info.size; }
+
+            /**
+             * @brief Gets the column data as a typed array.
+             * @tparam T The component type stored in this column.
+             * @return A pointer to the first element.
+             */
+            template <typename T>
+            inline T* as() noexcept {
+                IO_ASSERT_MSG(sizeof(T) == info.size, "Column does not store components of type T");
+                return reinterpret_cast<T*>(data);
+            }
+            template <typename T>
+            inline const T* as() const noexcept {
+                IO_ASSERT_MSG(sizeof(T) == info.size, "Column does not store components of type T");
+                return reinterpret_cast<const T*>(data);
+            }
+
+            inline const Component::Info& getInfo() const noexcept { return info; }
+            inline u64 getSize() const noexcept { return size; }
+
+            private:
+            Component::Info info;  ///< Layout and lifetime operations of the stored component.
+            byte* data;            ///< Aligned element storage.
+            u64 size;              ///< Number of constructed elements.
+            u64 capacity;          ///< Number of elements the storage can hold.
+
+            /**
+             * @brief Reallocates the storage, moving every element into the new buffer.
+             * @param count The new capacity in elements.
+             */
+            void grow(u64 count);
+        };
+    }  // namespace Archetype
+}  // namespace iodine::core
@@ -0,0 +1,100 @@
+#include "ecs/archetype/registry.hpp"
+
+namespace iodine::core {
+    namespace Archetype {
+        void Registry::remove(const Entity& entity, const Component::Info& info) {
+            if (!has(entity, info.id)) {
+                IO_WARN("Entity does not have component with ID: %u", info.id);
+                return;
+            }
+            migrate(entity, info, false);
+        }
+
+        void Registry::destroy(const Entity& entity) {
+            Table* table = getTable(entity);
+            if (!table) return;
+
+            Record& record = records[entity.getIndex()];
+            if (table->swapRemove(record.row)) {
+                records[table->getEntities()[record.row].getIndex()].row = record.row;
+            }
+            record = Record{};
+        }
+
+        b8 Registry::has(const Entity& entity, Component::ID id) const noexcept {
+            const Table* table = getTable(entity);
+            return table && table->has(id);
+        }
+
+        Table* Registry::getTable(const Entity& entity) const noexcept {
+            const u64 index = entity.getIndex();
+            return index < records.size() ? records[index].table : nullptr;
+        }
+
+        Table* Registry::neighbour(Table* from, const Component::Info& info, b8 add) {
+            if (from) {
+                if (Table* cached = from->getEdge(info.id, add)) return cached;
+            }
+
+            Component::Signature signature = from ? from->getSignature() : Component::Signature{};
+            std::vector<Component::Info> infos;
+            if (from) {
+                for (const Column& column : from->getColumns()) {
+                    if (add || column.getInfo().id != info.id) infos.push_back(column.getInfo());
+                }
+            }
+            if (add) {
+                signature.set(info.id);
+                infos.push_back(info);
+                std::ranges::sort(infos, {}, &Component::Info::id);
+            } else {
+                signature.reset(info.id);
+            }
+
+            Table* to = nullptr;
+            if (signature.any()) {
+                auto it = signatures.find(signature);
+                if (it != signatures.end()) {
+                    to = it->second;
+                } else {
+                    to = tables.emplace_back(MakeUnique<Table>(signature, infos)).get();
+                    signatures.emplace(signature, to);
+                }
+            }
+
+            if (from) from->setEdge(info.id, add, to);
+            if (to) to->setEdge(info.id, !add, from);
+            return to;
+        }
+
+        u64 Registry::migrate(const Entity& entity, const Component::Info& info, b8 add) {
+            const u64 index = entity.getIndex();
+            if (index >= records.size()) {
+                records.resize(index + 1);
+            }
+            Record& record = records[index];
+            Table* from = record.table;
+            Table* to = neighbour(from, info, add);
+
+            u64 row = 0;
+            if (to) {
+                row = to->append(entity);
+                if (from) {
+                    for (Column& column : from->getColumns()) {
+                        if (Column* target = to->getColumn(column.getInfo().id)) {
+                            column.getInfo().move(target->emplaceBack(), column.at(record.row));
+                        }
+                    }
+                }
+            }
+
+            if (from && from->swapRemove(record.row)) {
+                records[from->getEntities()[record.row].getIndex()].row = record.row;
+            }
+
+            record.table = to;
+            record.row = row;
+            return row;
+        }
+    }  // namespace Archetype
+}  // namespace iodine::core
@@ -0,0 +1,141 @@
+#pragma once
+
+#include "debug/log.hpp"
+#include "ecs/archetype/table.hpp"
+
+namespace iodine::core {
+    namespace Archetype {
+        /**
+         * @brief Owns every archetype table and tracks which table and row each entity lives in.
+         *        Adding or removing a component moves the entity's row into the table of its new signature.
+         */
+        class IO_API Registry {
+            public:
+            Registry() = default;
+            ~Registry() = default;
+            Registry(const Registry& other) = delete;
+            Registry(Registry&& other) noexcept = default;
+            Registry& operator=(const Registry& other) = delete;
+            Registry& operator=(Registry&& other) noexcept = default;
+
+            /**
+             * @brief Adds a component to an entity, moving the entity into the table that matches its new signature.
+             * @tparam T The component type.
+             * @tparam Args The types of the arguments to forward to the component constructor.
+             * @param entity The entity to add the component to.
+             * @param info The component info for T.
+             * @param ...args The arguments to forward to the component constructor.
+             * @return The stored component.
+             * @warning This function is not thread-safe.
+             */
+            template <typename T, typename... Args>
+            T& insert(const Entity& entity, const Component::Info& info, Args&&... args) {
+                if (has(entity, info.id)) {
+                    IO_WARN("Entity already has component with ID: %u", info.id);
+                    return get<T>(entity, info.id);
+                }
+                T component(std::forward<Args>(args)...);
+                const u64 row = migrate(entity, info, true);
+                Record& record = records[entity.getIndex()];
+                void* slot = record.table->getColumn(info.id)->emplaceBack();
+                info.move(slot, &component);
+                IO_ASSERT_MSG(row == record.row, "Archetype row mismatch after migration");
+                return *static_cast<T*>(slot);
+            }
+
+            /**
+             * @brief Removes a component from an entity, moving the entity into the table that matches its new signature.
+             * @param entity The entity to remove the component from.
+             * @param info The component info.
+             * @warning This function is not thread-safe.
+             */
+            void remove(const Entity& entity, const Component::Info& info);
+
+            /**
+             * @brief Removes every component of an entity.
+             * @param entity The entity to clear.
+             * @warning This function is not thread-safe.
+             */
+            void destroy(const Entity& entity);
+
+            /**
+             * @brief Gets a component of an entity.
+             * @tparam T The component type.
+             * @param entity The entity.
+             * @param id The component ID of T.
+             * @return The component.
+             */
+            template <typename T>
+            T& get(const Entity& entity, Component::ID id) {
+                IO_ASSERT_MSG(has(entity, id), "Entity does not have component T");
+                const Record& record = records[entity.getIndex()];
+                return record.table->getData<T>(id)[record.row];
+            }
+
+            /**
+             * @brief Checks whether an entity has a component.
+             * @param entity The entity.
+             * @param id The component ID.
+             * @return True if the entity has the component.
+             */
+            b8 has(const Entity& entity, Component::ID id) const noexcept;
+
+            /**
+             * @brief Gets the table an entity currently lives in.
+             * @param entity The entity.
+             * @return The table, or nullptr if the entity has no components.
+             */
+            Table* getTable(const Entity& entity) const noexcept;
+
+            /**
+             * @brief Calls a function for every non-empty table whose signature includes the given components.
+             * @tparam Function The function type, invocable with a Table&.
+             * @param required The components every visited table must hold.
+             * @param function The function to call.
+             */
+            template <typename Function>
+            void forEachTable(const Component::Signature& required, Function&& function) {
+                for (const Unique<Table>& table : tables) {
+                    if (table->getSize() > 0 && table->matches(required)) {
+                        function(*table);
+                    }
+                }
+            }
+
+            inline const std::vector<Unique<Table>>& getTables() const noexcept { return tables; }
+
+            private:
+            /**
+             * @brief Location of an entity's components.
+             */
+            struct Record {
+                Table* table = nullptr;  ///< The table holding the entity, nullptr if it has no components.
+                u64 row = 0;             ///< The row of the entity in its table.
+            };
+
+            std::vector<Unique<Table>> tables;                          ///< Every table, in creation order.
+            std::unordered_map<Component::Signature, Table*> signatures;  ///< Maps signatures to their tables.
+            std::vector<Record> records;                                ///< Maps entity indices to their location.
+
+            /**
+             * @brief Finds the table reached from another table by adding or removing a component, creating it if needed.
+             * @param from The source table, nullptr for the empty signature.
+             * @param info The component to add or remove.
+             * @param add True to add the component, false to remove it.
+             * @return The destination table, or nullptr for the empty signature.
+             */
+            Table* neighbour(Table* from, const Component::Info& info, b8 add);
+
+            /**
+             * @brief Moves an entity into the table reached by adding or removing a component.
+             *        Shared components are moved, a removed component is destroyed and an added component's column is left
+             *        one element short for the caller to fill.
+             * @param entity The entity to move.
+             * @param info The component being added or removed.
+             * @param add True if the component is being added, false if removed.
+             * @return The new row of the entity.
+             */
+            u64 migrate(const Entity& entity, const Component::Info& info, b8 add);
+        };
+    }  // namespace Archetype
+}  // namespace iodine::core
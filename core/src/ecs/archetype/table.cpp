@@ -0,0 +1,40 @@
+#include "ecs/archetype/table.hpp"
+
+namespace iodine::core {
+    namespace Archetype {
+        Table::Table(const Component::Signature& signature, const std::vector<Component::Info>& infos) : signature(signature) {
+            columns.reserve(infos.size());
+            for (const Component::Info& info : infos) {
+                if (info.id >= lookup.size()) {
+                    lookup.resize(info.id + 1, Absent);
+                }
+                lookup[info.id] = static_cast<u32>(columns.size());
+                columns.emplace_back(info);
+            }
+        }
+
+        u64 Table::append(const Entity& entity) {
+            entities.push_back(entity);
+            return entities.size() - 1;
+        }
+
+        b8 Table::swapRemove(u64 row) {
+            IO_ASSERT_MSG(row < entities.size(), "Table row out of bounds");
+            for (Column& column : columns) {
+                column.swapRemove(row);
+            }
+            const b8 moved = row != entities.size() - 1;
+            entities[row] = entities.back();
+            entities.pop_back();
+            return moved;
+        }
+
+        Table* Table::getEdge(Component::ID id, b8 add) const {
+            const auto& edges = add ? addEdges : removeEdges;
+            auto it = edges.find(id);
+            return it != edges.end() ? it->second : nullptr;
+        }
+
+        void Table::setEdge(Component::ID id, b8 add, Table* table) { (add ? addEdges : removeEdges)[id] = table; }
+    }  // namespace Archetype
+}  // namespace iodine::core
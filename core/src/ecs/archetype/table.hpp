@@ -0,0 +1,107 @@
+#pragma once
+
+#include "ecs/archetype/column.hpp"
+#include "ecs/entity/entity.hpp"
+
+namespace iodine::core {
+    namespace Archetype {
+        /**
+         * @brief Stores every entity that has exactly one set of components (its signature), one column per component.
+         *        Row i of every column belongs to the i-th entity of the table.
+         */
+        class IO_API Table {
+            public:
+            /**
+             * @brief Creates an empty table.
+             * @param signature The component set of the table.
+             * @param infos The component infos for every ID in the signature.
+             */
+            Table(const Component::Signature& signature, const std::vector<Component::Info>& infos);
+            ~Table() = default;
+            Table(const Table& other) = delete;
+            Table(Table&& other) noexcept = default;
+            Table& operator=(const Table& other) = delete;
+            Table& operator=(Table&& other) noexcept = default;
+
+            /**
+             * @brief Appends an entity to the table. Every column must be filled by the caller right after.
+             * @param entity The entity to append.
+             * @return The row of the entity.
+             */
+            u64 append(const Entity& entity);
+
+            /**
+             * @brief Removes a row, destroying its components and moving the last row into its place.
+             * @param row The row to remove.
+             * @return True if another entity was moved into the row.
+             */
+            b8 swapRemove(u64 row);
+
+            /**
+             * @brief Checks whether the table contains a component.
+             * @param id The component ID.
+             * @return True if every entity of this table has the component.
+             */
+            inline b8 has(Component::ID id) const noexcept { return id < lookup.size() && lookup[id] != Absent; }
+
+            /**
+             * @brief Checks whether the table holds every component of a signature.
+             * @param required The components to look for.
+             * @return True if the table signature is a superset of the given one.
+             */
+            inline b8 matches(const Component::Signature& required) const noexcept { return signature.includes(required); }
+
+            /**
+             * @brief Gets the column for a component.
+             * @param id The component ID.
+             * @return The column, or nullptr if the table does not contain the component.
+             */
+            inline Column* getColumn(Component::ID id) noexcept { return has(id) ? &columns[lookup[id]] : nullptr; }
+            inline const Column* getColumn(Component::ID id) const noexcept { return has(id) ? &columns[lookup[id]] : nullptr; }
+
+            /**
+             * @brief Gets the contiguous data of a component.
+             * @tparam T The component type.
+             * @param id The component ID.
+             * @return A pointer to the first component, with getSize() elements.
+             */
+            template <typename T>
+            inline T* getData(Component::ID id) noexcept {
+                IO_ASSERT_MSG(has(id), "Table does not contain the requested component");
+                return columns[lookup[id]].as<T>();
+            }
+
+            inline const Component::Signature& getSignature() const noexcept { return signature; }
+            inline const std::vector<Entity>& getEntities() const noexcept { return entities; }
+            inline std::vector<Column>& getColumns() noexcept { return columns; }
+            inline const std::vector<Column>& getColumns() const noexcept { return columns; }
+            inline u64 getSize() const noexcept { return entities.size(); }
+
+            /**
+             * @brief Gets the cached neighbour table reached by adding or removing a component.
+             * @param id The component ID.
+             * @param add True for the add edge, false for the remove edge.
+             * @return The neighbour table, or nullptr if the edge has not been resolved yet.
+             */
+            Table* getEdge(Component::ID id, b8 add) const;
+
+            /**
+             * @brief Caches the neighbour table reached by adding or removing a component.
+             * @param id The component ID.
+             * @param add True for the add edge, false for the remove edge.
+             * @param table The neighbour table.
+             */
+            void setEdge(Component::ID id, b8 add, Table* table);
+
+            private:
+            static constexpr u32 Absent = std::numeric_limits<u32>::max();
+
+            Component::Signature signature;                          ///< The components held by this table.
+            std::vector<Entity> entities;                            ///< The entity stored in each row.
+            std::vector<Column> columns;                             ///< One column per component, sorted by ID.
+            std::vector<u32> lookup;                                 ///< Maps component IDs to column indices.
+            std::unordered_map<Component::ID, Table*> addEdges;     ///< Tables reached by adding a component.
+            std::unordered_map<Component::ID, Table*> removeEdges;  ///< Tables reached by removing a component.
+        };
+    }  // namespace Archetype
+}  // namespace iodine::core
@@ -0,0 +1,41 @@
+#include "ecs/command/buffer.hpp"
+
+namespace iodine::core {
+    CommandBuffer::CommandBuffer(Entity::Registry& entities, Component::Registry& components) : entities(entities), components(components) {}
+
+    CommandBuffer::~CommandBuffer() { clear(); }
+
+    Entity CommandBuffer::spawn() { return entities.create(); }
+
+    void CommandBuffer::destroy(const Entity& entity) {
+        commands.push_back(Command{Command::Kind::Destroy, std::numeric_limits<Component::ID>::max(), entity, nullptr, nullptr, nullptr});
+    }
+
+    void CommandBuffer::clear() {
+        for (const Command& command : commands) {
+            if (command.drop) command.drop(command.payload);
+        }
+        commands.clear();
+        block = 0;
+        offset = 0;
+    }
+
+    void* CommandBuffer::allocate(u64 size, u64 alignment) {
+        while (block < blocks.size()) {
+            const u64 aligned = (offset + alignment - 1) & ~(alignment - 1);
+            if (aligned + size <= blockSizes[block]) {
+                offset = aligned + size;
+                return blocks[block].get() + aligned;
+            }
+            block++;
+            offset = 0;
+        }
+
+        const u64 capacity = std::max(BlockSize, size);
+        blocks.push_back(MakeUnique<byte[]>(capacity));
+        blockSizes.push_back(capacity);
+        block = blocks.size() - 1;
+        offset = size;
+        return blocks.back().get();
+    }
+}  // namespace iodine::core
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ecs/component/registry.hpp"
+#include "ecs/entity/registry.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Records structural changes (destroy / add / remove) for later playback at a sync point.
+     *        Commands are kept in a flat array and their component payloads in a block arena that never relocates.
+     * @note A command buffer must only be used by one thread at a time. See Commands for per-thread buffers.
+     */
+    class IO_API CommandBuffer {
+        public:
+        /**
+         * @brief A single recorded operation.
+         */
+        struct Command {
+            enum class Kind : u8 { Add, Remove, Destroy };
+
+            /**
+             * @brief Plays back a run of commands that share a component type.
+             */
+            using Playback = void (*)(Component::Registry& components, Entity::Registry& entities, const Command* const* first, const Command* const* last);
+
+            Kind kind;                ///< What the command does.
+            Component::ID id;         ///< The component type (Add / Remove).
+            Entity entity;            ///< The target entity.
+            void* payload;            ///< The component to add, constructed in the arena (Add only).
+            Playback playback;        ///< Applies a run of commands of this component type.
+            void (*drop)(void*);      ///< Destroys the payload (Add only).
+        };
+
+        /**
+         * @brief Creates an empty command buffer.
+         * @param entities The entity registry entities are reserved from.
+         * @param components The component registry commands are played back into.
+         */
+        CommandBuffer(Entity::Registry& entities, Component::Registry& components);
+        ~CommandBuffer();
+        CommandBuffer(const CommandBuffer&) = delete;
+        CommandBuffer(CommandBuffer&&) = delete;
+        CommandBuffer& operator=(const CommandBuffer&) = delete;
+        CommandBuffer& operator=(CommandBuffer&&) = delete;
+
+        /**
+         * @brief Creates a new entity. The entity is reserved immediately so commands can target it right away.
+         * @return The new entity.
+         */
+        Entity spawn();
+
+        /**
+         * @brief Records the destruction of an entity. Destructions are played back after every other command.
+         * @param entity The entity to destroy.
+         */
+        void destroy(const Entity& entity);
+
+        /**
+         * @brief Records adding a component to an entity.
+         * @tparam T The component type.
+         * @tparam Args The types of the arguments to forward to the component constructor.
+         * @param entity The entity to add the component to.
+         * @param ...args The arguments to forward to the component constructor.
+         */
+        template <Component::Component T, typename... Args>
+        void add(const Entity& entity, Args&&... args) {
+            STATIC_ASSERT(alignof(T) <= alignof(std::max_align_t), "Over-aligned components cannot be recorded");
+            void* payload = allocate(sizeof(T), alignof(T));
+            new (payload) T(std::forward<Args>(args)...);
+            commands.push_back(Command{Command::Kind::Add, components.enter<T>(), entity, payload, &play<T>,
+                                       [](void* ptr) { static_cast<T*>(ptr)->~T(); }});
+        }
+
+        /**
+         * @brief Records removing a component from an entity.
+         * @tparam T The component type.
+         * @param entity The entity to remove the component from.
+         */
+        template <Component::Component T>
+        void remove(const Entity& entity) {
+            commands.push_back(Command{Command::Kind::Remove, components.enter<T>(), entity, nullptr, &play<T>, nullptr});
+        }
+
+        /**
+         * @brief Drops every recorded command without playing it back. Arena blocks are kept for reuse.
+         */
+        void clear();
+
+        inline const std::vector<Command>& getCommands() const noexcept { return commands; }
+        inline u64 getSize() const noexcept { return commands.size(); }
+        inline b8 isEmpty() const noexcept { return commands.empty(); }
+
+        private:
+        static constexpr u64 BlockSize = 64 * 1024;  ///< The default arena block size in bytes.
+
+        Entity::Registry& entities;         ///< Source of reserved entities.
+        Component::Registry& components;    ///< Resolves component IDs.
+        std::vector<Command> commands;      ///< The recorded commands.
+        std::vector<Unique<byte[]>> blocks;  ///< Arena blocks holding payloads.
+        std::vector<u64> blockSizes;        ///< The size of each arena block.
+        u64 block = 0;                      ///< The arena block currently being filled.
+        u64 offset = 0;                     ///< The fill level of the current block.
+
+        /**
+         * @brief Allocates payload memory from the arena.
+         * @param size The number of bytes.
+         * @param alignment The required alignment.
+         * @return Uninitialized memory.
+         */
+        void* allocate(u64 size, u64 alignment);
+
+        /**
+         * @brief Plays back a run of Add / Remove commands for one component type, touching its storage once.
+         */
+        template <Component::Component T>
+        static void play(Component::Registry& components, Entity::Registry& entities, const Command* const* first, const Command* const* last) {
+            if (components.getMode() == Component::Mode::Sparse) {
+                Component::Pool<T>* pool = components.getPool<T>();
+                for (; first != last; first++) {
+                    const Command& command = **first;
+                    if (!entities.isAlive(command.entity)) continue;
+                    if (command.kind == Command::Kind::Add) {
+                        components.emplaceInto(*pool, command.entity, std::move(*static_cast<T*>(command.payload)));
+                    } else {
+                        components.removeFrom(*pool, command.entity);
+                    }
+                }
+                return;
+            }
+            for (; first != last; first++) {
+                const Command& command = **first;
+                if (!entities.isAlive(command.entity)) continue;
+                if (command.kind == Command::Kind::Add) {
+                    components.create<T>(command.entity, std::move(*static_cast<T*>(command.payload)));
+                } else {
+                    components.remove<T>(command.entity);
+                }
+            }
+        }
+    };
+}  // namespace iodine::core
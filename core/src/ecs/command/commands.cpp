@@ -0,0 +1,52 @@
+#include "ecs/command/commands.hpp"
+
+namespace iodine::core {
+    static std::atomic<u64> nextSerial{1};  ///< Serial numbers of Commands instances, never reused.
+
+    Commands::Commands(Entity::Registry& entities, Component::Registry& components)
+        : entities(entities), components(components), serial(nextSerial.fetch_add(1, std::memory_order_relaxed)) {}
+
+    CommandBuffer& Commands::local() {
+        struct Cache {
+            u64 serial = 0;
+            CommandBuffer* buffer = nullptr;
+        };
+        static thread_local Cache cache;
+        if (cache.serial == serial) return *cache.buffer;
+
+        std::lock_guard lock(buffersLock);
+        Unique<CommandBuffer>& buffer = buffers[std::this_thread::get_id()];
+        if (!buffer) buffer = MakeUnique<CommandBuffer>(entities, components);
+        cache = {serial, buffer.get()};
+        return *buffer;
+    }
+
+    void Commands::flush() {
+        using Command = CommandBuffer::Command;
+
+        pending.clear();
+        for (const auto& [thread, buffer] : buffers) {
+            for (const Command& command : buffer->getCommands()) pending.push_back(&command);
+        }
+        if (pending.empty()) return;
+
+        // Destructions carry the largest ID and therefore sort last.
+        std::ranges::stable_sort(pending, {}, [](const Command* command) { return command->id; });
+
+        u64 begin = 0;
+        while (begin < pending.size() && pending[begin]->kind != Command::Kind::Destroy) {
+            u64 end = begin + 1;
+            while (end < pending.size() && pending[end]->id == pending[begin]->id) end++;
+            pending[begin]->playback(components, entities, pending.data() + begin, pending.data() + end);
+            begin = end;
+        }
+        for (; begin < pending.size(); begin++) {
+            const Entity& entity = pending[begin]->entity;
+            if (!entities.isAlive(entity)) continue;
+            components.destroy(entity);
+            entities.destroy(entity);
+        }
+
+        for (auto& [thread, buffer] : buffers) buffer->clear();
+    }
+}  // namespace iodine::core
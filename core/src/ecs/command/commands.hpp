@@ -0,0 +1,47 @@
+#pragma once
+
+#include <thread>
+
+#include "ecs/command/buffer.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Hands out one command buffer per thread and plays all of them back in one batch.
+     */
+    class IO_API Commands {
+        public:
+        /**
+         * @brief Creates an empty set of command buffers.
+         * @param entities The entity registry of the owning world.
+         * @param components The component registry of the owning world.
+         */
+        Commands(Entity::Registry& entities, Component::Registry& components);
+        ~Commands() = default;
+        Commands(const Commands&) = delete;
+        Commands(Commands&&) = delete;
+        Commands& operator=(const Commands&) = delete;
+        Commands& operator=(Commands&&) = delete;
+
+        /**
+         * @brief Gets the command buffer of the calling thread, creating it on first use.
+         * @return The thread's command buffer.
+         * @note This function is thread-safe. After the first call on a thread it does not lock.
+         */
+        CommandBuffer& local();
+
+        /**
+         * @brief Plays back and clears every buffer. Commands are sorted by component type so each storage is touched once,
+         *        keeping recording order within a type; destructions run last.
+         * @warning This function is not thread-safe. Call it at a sync point.
+         */
+        void flush();
+
+        private:
+        Entity::Registry& entities;                                            ///< The owning world's entities.
+        Component::Registry& components;                                       ///< The owning world's components.
+        const u64 serial;                                                      ///< Identifies this instance in thread-local caches.
+        std::mutex buffersLock;                                                ///< Protects the buffer map.
+        std::unordered_map<std::thread::id, Unique<CommandBuffer>> buffers;  ///< One buffer per recording thread.
+        std::vector<const CommandBuffer::Command*> pending;                    ///< Scratch list reused by flush().
+    };
+}  // namespace iodine::core
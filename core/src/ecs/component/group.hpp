@@ -0,0 +1,181 @@
+#pragma once
+
+#include <algorithm>
+#include <tuple>
+
+#include "ecs/component/pool.hpp"
+#include "ecs/component/types.hpp"
+#include "ecs/entity/registry.hpp"
+
+namespace iodine::core {
+    namespace Component {
+        /**
+         * @brief Type-erased base of every group, so registries can own groups of any component set.
+         */
+        class IO_API GroupBase {
+            public:
+            virtual ~GroupBase() = default;
+
+            /**
+             * @brief Gets the signature of the owned component types.
+             * @return The signature.
+             */
+            virtual const Signature& getSignature() const noexcept = 0;
+
+            /**
+             * @brief Packs the group again from scratch, after its pools were overwritten wholesale.
+             */
+            virtual void refresh() = 0;
+        };
+
+        /**
+         * @brief Owns two or more pools and keeps every entity that has all of their components packed at the front of
+         *        each pool's dense array, in the same order. Iterating a group is a lockstep loop over [0, getSize()) of
+         *        every array, without lookups.
+         *        Membership is maintained on insertion and removal with one swap per pool.
+         * @tparam Ts The owned component types. A pool can be owned by a single group only.
+         */
+        template <Component... Ts>
+        class IO_API Group : public GroupBase {
+            STATIC_ASSERT(sizeof...(Ts) >= 2, "A group owns at least two pools");
+
+            using Indices = std::index_sequence_for<Ts...>;
+
+            /// The longest stretch of positions that is contiguous in every owned pool: the smallest chunk capacity.
+            static constexpr u64 Run = std::min({(Pool<Ts>::ChunkCapacity ? Pool<Ts>::ChunkCapacity : ~u64(0))...});
+
+            public:
+            /**
+             * @brief Takes ownership of the pools and packs the entities that already have every component.
+             * @param entities The entity registry used to resolve entity versions.
+             * @param pools The pools to own.
+             * @throws Exception::Type::InvalidArgument if a pool already belongs to a group.
+             */
+            Group(const Entity::Registry& entities, Pool<Ts>*... pools) : entities(&entities), pools(pools...) {
+                if ((pools->getOwner().group || ...)) {
+                    THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Pool is already owned by a group");
+                }
+                (pools->setOwner(Owner{this, &Group::inserted, &Group::removing}), ...);
+
+                refresh();
+            }
+
+            ~Group() override {
+                std::apply([](auto*... pools) { (pools->setOwner(Owner{}), ...); }, pools);
+            }
+
+            Group(const Group&) = delete;
+            Group& operator=(const Group&) = delete;
+
+            const Signature& getSignature() const noexcept override { return Types::signatureOf<Ts...>(); }
+
+            void refresh() override {
+                size = 0;
+                const Pool<std::tuple_element_t<0, std::tuple<Ts...>>>* first = std::get<0>(pools);
+                for (u64 position = 0; position < first->getSize(); position++) {
+                    inserted(this, first->getIndices()[position]);
+                }
+            }
+
+            /**
+             * @brief Calls a function for every entity in the group, walking every owned array in lockstep.
+             *        Every component is marked changed, as with a non-const view.
+             * @tparam Function Invocable with (Entity, Ts&...) or (Ts&...).
+             * @param function The function to call.
+             */
+            template <typename Function>
+            void each(Function&& function) {
+                eachPacked(function, Indices{});
+            }
+
+            /**
+             * @brief Gets the number of entities that have every owned component.
+             * @return The length of the packed range.
+             */
+            inline u64 getSize() const noexcept { return size; }
+
+            /**
+             * @brief Gets the entity indices of the group, in packed order.
+             * @return A pointer to the first index. There are getSize() indices.
+             */
+            inline const u64* getIndices() const noexcept { return std::get<0>(pools)->getIndices(); }
+
+            /**
+             * @brief Gets the packed component array of an owned type.
+             * @tparam T The owned component type.
+             * @return A pointer to the first component. There are getSize() components.
+             */
+            template <Component T>
+                requires(!Chunked<T> && !std::is_empty_v<T>)
+            inline T* getData() noexcept {
+                Pool<T>* pool = std::get<Pool<T>*>(pools);
+                return size ? &pool->getAt(0) : nullptr;
+            }
+
+            private:
+            const Entity::Registry* entities;  ///< Resolves entity indices to entities.
+            std::tuple<Pool<Ts>*...> pools;    ///< The owned pools.
+            u64 size = 0;                      ///< The number of packed entities.
+
+            /**
+             * @brief Packs an entity whose component was just inserted, if it now has every owned component.
+             */
+            static void inserted(void* self, u64 index) {
+                Group& group = *static_cast<Group*>(self);
+                const b8 member = std::apply([index](auto*... pools) { return (pools->find(index) && ...); }, group.pools);
+                if (!member || std::get<0>(group.pools)->getPosition(index) < group.size) return;
+                std::apply([&](auto*... pools) { (pools->swap(pools->getIndices()[group.size], index), ...); }, group.pools);
+                group.size++;
+            }
+
+            /**
+             * @brief Moves an entity that is about to lose a component out of the packed range.
+             */
+            static void removing(void* self, u64 index) {
+                Group& group = *static_cast<Group*>(self);
+                const b8 member = std::apply([index](auto*... pools) { return (pools->find(index) && ...); }, group.pools);
+                if (!member || std::get<0>(group.pools)->getPosition(index) >= group.size) return;
+                group.size--;
+                std::apply([&](auto*... pools) { (pools->swap(pools->getIndices()[group.size], index), ...); }, group.pools);
+            }
+
+            /**
+             * @brief Gets an element of a packed run. Tag pools hold one shared instance, so their stride is zero.
+             */
+            template <typename T>
+            static inline T& element(T* run, u64 offset) noexcept {
+                if constexpr (std::is_empty_v<T>) {
+                    return *run;
+                } else {
+                    return run[offset];
+                }
+            }
+
+            template <typename Function, std::size_t... I>
+            void eachPacked(Function& function, std::index_sequence<I...>) {
+                if (size == 0) return;
+                const u64* indices = getIndices();
+                for (u64 first = 0; first < size; first += Run) {
+                    // Chunk capacities are powers of two, so a run never crosses a chunk boundary of any pool.
+                    std::tuple<Ts*...> arrays{&std::get<I>(pools)->getAt(first)...};
+                    const u64 last = std::min(size, first + Run);
+                    for (u64 position = first; position < last; position++) {
+                        if constexpr (std::is_invocable_v<Function&, Entity, Ts&...>) {
+                            function(entities->at(indices[position]), element(std::get<I>(arrays), position - first)...);
+                        } else {
+                            function(element(std::get<I>(arrays), position - first)...);
+                        }
+                    }
+                }
+                (
+                    [&] {
+                        auto* pool = std::get<I>(pools);
+                        pool->touch();
+                        const Tick now = pool->getClock().now();
+                        for (u64 position = 0; position < size; position++) pool->markChangedAt(position, now);
+                    }(),
+                    ...);
+            }
+        };
+    }  // namespace Component
+}  // namespace iodine::core
@@ -1,22 +1,55 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <span>
+#include <vector>
 
 #include "container/sparse_set.hpp"
 #include "debug/log.hpp"
 #include "ecs/component/storage.hpp"
+#include "ecs/component/types.hpp"
 #include "ecs/entity/entity.hpp"
+#include "ecs/snapshot/snapshot.hpp"
 
 namespace iodine::core {
     namespace Component {
+        /**
+         * @brief Callbacks of the group that owns a pool, keeping the group's packed range up to date.
+         */
+        struct IO_API Owner {
+            void* group = nullptr;                               ///< The owning group, nullptr if the pool is free.
+            void (*inserted)(void* group, u64 index) = nullptr;  ///< Called after a component was inserted.
+            void (*removing)(void* group, u64 index) = nullptr;  ///< Called before a component is removed.
+        };
+
+        /**
+         * @brief Records that two pools held equal contents at the given revisions.
+         */
+        struct IO_API Sync {
+            const Storage* peer = nullptr;  ///< The other pool.
+            u64 peerRevision = 0;           ///< The other pool's revision at the copy.
+            u64 ownRevision = 0;            ///< This pool's revision at the copy.
+        };
+
         /**
          * @brief Manages the pool of a component type.
+         *        Every component carries a Stamp in a parallel dense array, and removals are recorded with their tick,
+         *        so that views can filter on Added / Changed and systems can react to removals.
+         *        Pools of empty types (tags) only track membership, without a data array.
+         *        A revision counter follows the same mutations as change detection, so copies can skip unchanged pools.
          * @tparam T The component type to manage.
          */
         template <Component T>
         class IO_API Pool : public Storage {
             public:
-            Pool() : type(Reflect::reflect<T>().getType()) {}
+            static constexpr u64 ChunkCapacity = SparseSet<T, Chunked<T>>::ChunkCapacity;  ///< Components per chunk, 0 if contiguous.
+
+            /**
+             * @brief Creates an empty pool.
+             * @param clock The clock of the owning registry, used to stamp insertions, changes and removals.
+             */
+            explicit Pool(const Clock& clock) : type(Reflect::reflect<T>().getType()), clock(&clock) {}
             ~Pool() = default;
             Pool(const Pool& other) = delete;
             Pool(Pool&& other) noexcept = default;
@@ -24,12 +57,14 @@ namespace iodine::core {
             Pool& operator=(Pool&& other) noexcept = default;
 
             /**
-             * @brief Gets the component for the given entity.
+             * @brief Gets the component for the given entity and marks it changed.
              * @param entity The entity to get the component for.
              * @return The component for the given entity.
              */
             T& get(const Entity& entity) {
                 IO_ASSERT_MSG(entities.contains(entity.getIndex()), "Entity does not have component T");
+                stamps[entities.getPosition(entity.getIndex())].changed = clock->now();
+                revision++;
                 return entities[entity.getIndex()];
             }
 
@@ -43,6 +78,13 @@ namespace iodine::core {
                 return entities[entity.getIndex()];
             }
 
+            /**
+             * @brief Checks whether the given entity has a component in this pool.
+             * @param entity The entity to check.
+             * @return True if the entity has the component, false otherwise.
+             */
+            inline b8 contains(const Entity& entity) const noexcept { return entities.contains(entity.getIndex()); }
+
             /**
              * @brief Inserts the component for the given entity.
              * @param entity The entity to insert the component for.
@@ -54,6 +96,8 @@ namespace iodine::core {
                     return;
                 }
                 entities.emplace(entity.getIndex(), component);
+                stamp();
+                notifyInserted(entity.getIndex());
             }
 
             /**
@@ -68,6 +112,25 @@ namespace iodine::core {
                     return;
                 }
                 entities.emplace(entity.getIndex(), T(std::forward<Args>(args)...));
+                stamp();
+                notifyInserted(entity.getIndex());
+            }
+
+            /**
+             * @brief Inserts a copy of a component for every given entity, growing the dense arrays once.
+             *        Entities that already have the component are skipped.
+             * @param batch The entities to insert the component for.
+             * @param component The component to copy.
+             */
+            void insertBatch(std::span<const Entity> batch, const T& component) {
+                entities.reserve(batch.size());
+                stamps.reserve(entities.getSize() + batch.size());
+                for (const Entity& entity : batch) {
+                    if (entities.contains(entity.getIndex())) continue;
+                    entities.insert(entity.getIndex(), component);
+                    stamp();
+                    notifyInserted(entity.getIndex());
+                }
             }
 
             /**
@@ -79,9 +142,283 @@ namespace iodine::core {
                     IO_WARN("Entity does not have component of type: %s", getType().getName().c_str());
                     return;
                 }
+                erase(entity);
+            }
+
+            /**
+             * @brief Removes the component for the given entity, if it has one.
+             * @param entity The entity to remove the component for.
+             */
+            void erase(const Entity& entity) override {
+                if (!entities.contains(entity.getIndex())) return;
+                if (owner.group) owner.removing(owner.group, entity.getIndex());
+                const u64 position = entities.getPosition(entity.getIndex());
+                revision++;
+                membership++;
+                stamps[position] = stamps.back();
+                stamps.pop_back();
                 entities.erase(entity.getIndex());
+                removed.emplace_back(entity, clock->now());
+            }
+
+            /**
+             * @brief Swaps the dense positions of two entities' components, along with their stamps.
+             * @param index1 The first entity index, must have a component in this pool.
+             * @param index2 The second entity index, must have a component in this pool.
+             */
+            void swap(u64 index1, u64 index2) {
+                std::swap(stamps[entities.getPosition(index1)], stamps[entities.getPosition(index2)]);
+                entities.swap(index1, index2);
+                revision++;
+            }
+
+            /**
+             * @brief Sorts the components in place. Dense order, sparse positions and stamps move together.
+             * @tparam Compare A strict weak ordering invocable with (const T&, const T&).
+             * @param compare The ordering.
+             * @throws Exception::Type::InvalidArgument if the pool is owned by a group.
+             */
+            template <typename Compare>
+            void sort(Compare compare) {
+                assertFree();
+                revision++;
+                entities.sort(compare, [this](u64 position1, u64 position2) { std::swap(stamps[position1], stamps[position2]); });
+            }
+
+            /**
+             * @brief Sorts the components with an insertion sort, cheap when the pool is already mostly sorted.
+             * @tparam Compare A strict weak ordering invocable with (const T&, const T&).
+             * @param compare The ordering.
+             * @throws Exception::Type::InvalidArgument if the pool is owned by a group.
+             */
+            template <typename Compare>
+            void sortIncremental(Compare compare) {
+                assertFree();
+                revision++;
+                entities.sortIncremental(compare, [this](u64 position1, u64 position2) { std::swap(stamps[position1], stamps[position2]); });
+            }
+
+            /**
+             * @brief Reorders the pool so that entities also present in another pool come first, in that pool's order.
+             *        Entities missing from the other pool follow in unspecified order.
+             * @tparam U The component type of the other pool.
+             * @param other The pool whose order to follow.
+             * @throws Exception::Type::InvalidArgument if the pool is owned by a group.
+             */
+            template <Component U>
+            void sortAs(const Pool<U>& other) {
+                sortAs(std::span<const u64>(other.getIndices(), other.getSize()));
+            }
+
+            /**
+             * @brief Reorders the pool so that the given entities come first, in the given order.
+             *        Indices without a component in this pool are skipped; the remaining entities follow in unspecified order.
+             * @param order The entity indices, each appearing once.
+             * @throws Exception::Type::InvalidArgument if the pool is owned by a group.
+             */
+            void sortAs(std::span<const u64> order) {
+                assertFree();
+                revision++;
+                u64 position = 0;
+                for (const u64 index : order) {
+                    if (!entities.contains(index)) continue;
+                    const u64 current = entities.getPosition(index);
+                    entities.swapAt(position, current);
+                    std::swap(stamps[position], stamps[current]);
+                    position++;
+                }
+            }
+
+            /**
+             * @brief Hands the pool to a group, or releases it.
+             * @param owner The group's callbacks, or a default Owner to release the pool.
+             */
+            inline void setOwner(const Owner& owner) noexcept { this->owner = owner; }
+            inline const Owner& getOwner() const noexcept { return owner; }
+
+            /**
+             * @brief Gets the clock the pool stamps insertions and removals with.
+             * @return The owning registry's clock.
+             */
+            inline const Clock& getClock() const noexcept { return *clock; }
+
+            /**
+             * @brief Gets the change stamp of an entity's component.
+             * @param index The entity index.
+             * @return A pointer to the stamp, or nullptr if the entity has no component in this pool.
+             */
+            inline const Stamp* getStamp(u64 index) const noexcept { return entities.contains(index) ? &stamps[entities.getPosition(index)] : nullptr; }
+
+            /**
+             * @brief Gets the change stamp at a dense position, without any checks.
+             * @param position The dense position, must be smaller than getSize().
+             * @return The stamp.
+             */
+            inline Stamp& getStampAt(u64 position) noexcept { return stamps[position]; }
+            inline const Stamp& getStampAt(u64 position) const noexcept { return stamps[position]; }
+
+            /**
+             * @brief Marks the component at a dense position as changed. Safe to call concurrently for distinct
+             *        positions; call touch() once for the whole batch.
+             * @param position The dense position, must be smaller than getSize().
+             * @param tick The tick to stamp, taken once by the caller from Clock::now(): worker threads do not see the
+             *             running system's tick.
+             */
+            inline void markChangedAt(u64 position, Tick tick) noexcept { stamps[position].changed = tick; }
+
+            /**
+             * @brief Records that components were written through markChangedAt, so dirty copies notice the pool changed.
+             *        Call it once per iteration or parallel dispatch, from the calling thread.
+             */
+            inline void touch() noexcept { revision++; }
+
+            /**
+             * @brief Gets a counter that moves with every tracked mutation: insertions, removals, reordering and writes.
+             * @return The revision. Only comparisons for equality are meaningful.
+             */
+            inline u64 getRevision() const noexcept { return revision; }
+
+            /**
+             * @brief Gets a counter that moves whenever a component is inserted or removed, but not on writes or
+             *        reordering. Lets observers notice structural changes without scanning the stamps.
+             * @return The membership revision. Only comparisons for equality are meaningful.
+             */
+            inline u64 getMembership() const noexcept { return membership; }
+
+            /**
+             * @brief Calls a function for every entity whose component was removed after the given tick.
+             * @tparam Function Invocable with an Entity.
+             * @param since Removals stamped at or before this tick are skipped.
+             * @param function The function to call.
+             */
+            template <typename Function>
+            void forEachRemoved(Tick since, Function&& function) const {
+                for (const auto& [entity, tick] : removed) {
+                    if (tick > since) function(entity);
+                }
             }
 
+            /**
+             * @brief Forgets removals recorded before the given tick.
+             * @param before The oldest tick to keep.
+             */
+            void trimRemoved(Tick before) override {
+                std::erase_if(removed, [before](const std::pair<Entity, Tick>& entry) { return entry.second < before; });
+            }
+
+            void clear() override {
+                if (owner.group) {
+                    const std::vector<u64> indices(entities.getIndices(), entities.getIndices() + entities.getSize());
+                    for (const u64 index : indices) owner.removing(owner.group, index);
+                }
+                entities = SparseSet<T, Chunked<T>>();
+                stamps.clear();
+                removed.clear();
+                revision++;
+                membership++;
+            }
+
+            u64 getHash() const noexcept override { return Types::hash<T>(); }
+
+            void save(Snapshot::Writer& out) const override {
+                out.write<u64>(entities.getSize());
+                out.write(entities.getIndices(), entities.getSize() * sizeof(u64));
+                if constexpr (std::is_empty_v<T>) {
+                    return;
+                } else if constexpr (std::is_trivially_copyable_v<T>) {
+                    entities.forEachBlock([&](const T* first, u64 count) { out.write(first, count * sizeof(T)); });
+                } else {
+                    for (u64 position = 0; position < entities.getSize(); position++) out.writeFields(getType(), &entities.getAt(position));
+                }
+            }
+
+            std::span<const u64> load(Snapshot::Reader& in, u64 limit) override {
+                IO_ASSERT_MSG(entities.getSize() == 0, "Snapshots load into empty pools");
+                const u64 count = in.read<u64>();
+                if (count > in.getRemaining() / sizeof(u64)) {
+                    THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Snapshot is truncated");
+                }
+                std::vector<u64> indices(count);
+                in.read(indices.data(), count * sizeof(u64));
+                std::vector<u64> sorted = indices;
+                std::sort(sorted.begin(), sorted.end());
+                if (std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end()) {
+                    THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Snapshot holds a component twice for one entity");
+                }
+                if (!sorted.empty() && sorted.back() >= limit) {
+                    THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Snapshot holds a component for an entity index it never handed out");
+                }
+
+                if constexpr (std::is_trivially_copyable_v<T>) {
+                    entities.insertBatch(indices, std::is_empty_v<T> ? nullptr : in.take(count * sizeof(T)));
+                } else if constexpr (std::default_initializable<T>) {
+                    entities.reserve(count);
+                    for (const u64 index : indices) {
+                        T component{};
+                        in.readFields(getType(), &component);
+                        entities.insert(index, std::move(component));
+                    }
+                } else {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Components loaded field by field must be default constructible");
+                }
+
+                const Tick now = clock->now();
+                stamps.assign(count, Stamp{now, now});
+                revision++;
+                membership++;
+                for (const u64 index : indices) notifyInserted(index);
+                return {entities.getIndices(), entities.getSize()};
+            }
+
+            Unique<Storage> makeEmpty(const Clock& clock) const override { return MakeUnique<Pool>(clock); }
+
+            void copyFrom(const Storage& other) override {
+                const Pool& source = static_cast<const Pool&>(other);
+                entities = source.entities;
+                stamps = source.stamps;
+                removed = source.removed;
+                revision++;
+                membership++;
+                sync = {&source, source.revision, revision};
+                source.sync = {this, revision, source.revision};
+            }
+
+            b8 isSyncedWith(const Storage& other) const noexcept override {
+                const Pool& source = static_cast<const Pool&>(other);
+                return sync.peer == &source && sync.peerRevision == source.revision && sync.ownRevision == revision;
+            }
+
+            /**
+             * @brief Looks up the component for an entity index without asserting.
+             * @param index The entity index.
+             * @return A pointer to the component, or nullptr if the entity has none.
+             */
+            inline T* find(u64 index) noexcept { return entities.find(index); }
+            inline const T* find(u64 index) const noexcept { return entities.find(index); }
+
+            /**
+             * @brief Gets the component at a dense position, without any checks.
+             * @param position The dense position, must be smaller than getSize().
+             * @return The component.
+             */
+            inline T& getAt(u64 position) noexcept { return entities.getAt(position); }
+            inline const T& getAt(u64 position) const noexcept { return entities.getAt(position); }
+
+            /**
+             * @brief Gets the dense position of an entity index, without any checks.
+             * @param index The entity index, must have a component in this pool.
+             * @return The dense position.
+             */
+            inline u64 getPosition(u64 index) const noexcept { return entities.getPosition(index); }
+
+            /**
+             * @brief Gets the entity indices of this pool in dense order.
+             * @return A pointer to the first index. There are getSize() indices.
+             */
+            inline const u64* getIndices() const noexcept { return entities.getIndices(); }
+
+            inline u64 getSize() const noexcept { return entities.getSize(); }
+
             /**
              * @brief Gets the reflected type for this pool's component type.
              * @return The reflected type for this pool's component type.
@@ -91,15 +428,64 @@ namespace iodine::core {
                 return type;
             }
 
-            inline std::vector<T>::iterator begin() { return entities.begin(); }
-            inline std::vector<T>::iterator end() { return entities.end(); }
+            inline auto begin()
+                requires(!std::is_empty_v<T>)
+            {
+                return entities.begin();
+            }
+            inline auto end()
+                requires(!std::is_empty_v<T>)
+            {
+                return entities.end();
+            }
 
-            inline std::vector<T>::const_iterator begin() const { return entities.begin(); }
-            inline std::vector<T>::const_iterator end() const { return entities.end(); }
+            inline auto begin() const
+                requires(!std::is_empty_v<T>)
+            {
+                return entities.begin();
+            }
+            inline auto end() const
+                requires(!std::is_empty_v<T>)
+            {
+                return entities.end();
+            }
 
             private:
-            SparseSet<T> entities;  ///< The entities with this component.
-            Type& type;             ///< The reflected type for this component.
+            SparseSet<T, Chunked<T>> entities;             ///< The entities with this component.
+            Type& type;                                    ///< The reflected type for this component.
+            std::vector<Stamp> stamps;                     ///< Change stamps, parallel to the dense component array.
+            std::vector<std::pair<Entity, Tick>> removed;  ///< Recent removals and the tick they happened at.
+            const Clock* clock;                            ///< The owning registry's clock.
+            Owner owner;                                   ///< The group keeping this pool packed, if any.
+            u64 revision = 0;                              ///< Bumped by every tracked mutation, for dirty copies.
+            u64 membership = 0;                            ///< Bumped by every insertion and removal.
+            mutable Sync sync;                             ///< The pool this one was last copied to or from.
+
+            /**
+             * @brief Rejects reordering a pool whose front is kept packed by a group.
+             */
+            inline void assertFree() const {
+                if (owner.group) {
+                    THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Cannot sort a pool owned by a group");
+                }
+            }
+
+            /**
+             * @brief Tells the owning group, if any, that a component was inserted.
+             */
+            inline void notifyInserted(u64 index) {
+                if (owner.group) owner.inserted(owner.group, index);
+            }
+
+            /**
+             * @brief Stamps the component that was just appended as added and changed now.
+             */
+            inline void stamp() {
+                const Tick now = clock->now();
+                stamps.push_back({now, now});
+                revision++;
+                membership++;
+            }
         };
     }  // namespace Component
 }  // namespace iodine::core
\ No newline at end of file
@@ -1,28 +1,42 @@
 #pragma once
 
-#include <shared_mutex>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
 
+#include "ecs/archetype/registry.hpp"
+#include "ecs/component/group.hpp"
 #include "ecs/component/pool.hpp"
+#include "ecs/component/types.hpp"
 
 namespace iodine::core {
     namespace Component {
         /**
          * @brief Manages the registration, creation, and destruction of components.
          *        Every component must implement reflection and a copy-constructor to be registered.
+         *        Components are either kept in one pool per type (Mode::Sparse) or in archetype tables (Mode::Archetype).
          */
         class IO_API Registry {
             public:
-            Registry() = default;
+            static constexpr u64 Capacity = Types::Capacity;  ///< Maximum number of component types a registry can hold pools for.
+
+            /**
+             * @brief Creates a new component registry.
+             * @param mode The storage layout used for every component in this registry.
+             */
+            explicit Registry(Mode mode = Mode::Sparse) : mode(mode), table(Capacity) {}
             ~Registry() = default;
 
             /**
              * @brief Registers a component type with the registry.
              * @tparam T The component type to register.
              * @return The ID of the registered component.
-             * @note This is not technically necessary but should be used as a sanity check.
+             * @note This is not technically necessary but should be used as a sanity check. In sparse mode it also creates
+             *       the pool, which snapshots need in order to be loaded into a fresh registry.
              */
             template <Component T>
             ID enter() {
+                if (mode == Mode::Sparse) getPool<T>();
                 return getID<T>();
             }
 
@@ -35,8 +49,12 @@ namespace iodine::core {
              */
             template <Component T>
             T& create(const Entity& entity, T& component) {
+                if (mode == Mode::Archetype) {
+                    return archetypes.insert<T>(entity, Info::of<T>(getID<T>()), component);
+                }
                 Pool<T>* pool = getPool<T>();
                 pool->insert(entity, component);
+                mask(entity).set(getID<T>());
                 return pool->get(entity);
             }
 
@@ -51,11 +69,62 @@ namespace iodine::core {
              */
             template <Component T, typename... Args>
             T& create(const Entity& entity, Args&&... args) {
+                if (mode == Mode::Archetype) {
+                    return archetypes.insert<T>(entity, Info::of<T>(getID<T>()), std::forward<Args>(args)...);
+                }
                 Pool<T>* pool = getPool<T>();
                 pool->emplace(entity, std::forward<Args>(args)...);
+                mask(entity).set(getID<T>());
                 return pool->get(entity);
             }
 
+            /**
+             * @brief Creates a copy of a component for every given entity.
+             * @tparam T The component type to create.
+             * @param batch The entities to create the component for.
+             * @param component The component to copy.
+             * @warning This function is not thread-safe.
+             */
+            template <Component T>
+            void createBatch(std::span<const Entity> batch, const T& component) {
+                if (mode == Mode::Archetype) {
+                    const Info info = Info::of<T>(getID<T>());
+                    for (const Entity& entity : batch) archetypes.insert<T>(entity, info, component);
+                    return;
+                }
+                getPool<T>()->insertBatch(batch, component);
+                const ID id = getID<T>();
+                for (const Entity& entity : batch) mask(entity).set(id);
+            }
+
+            /**
+             * @brief Emplaces a component into a pool previously fetched with getPool(), keeping the entity's mask in sync.
+             *        Lets callers that insert many components of one type look the pool up once.
+             * @tparam T The component type.
+             * @param pool The pool of T.
+             * @param entity The entity to create the component for.
+             * @param ...args The arguments to forward to the component constructor.
+             * @warning This function is not thread-safe. Sparse mode only.
+             */
+            template <Component T, typename... Args>
+            void emplaceInto(Pool<T>& pool, const Entity& entity, Args&&... args) {
+                pool.emplace(entity, std::forward<Args>(args)...);
+                mask(entity).set(getID<T>());
+            }
+
+            /**
+             * @brief Removes a component from a pool previously fetched with getPool(), keeping the entity's mask in sync.
+             * @tparam T The component type.
+             * @param pool The pool of T.
+             * @param entity The entity to remove the component from.
+             * @warning This function is not thread-safe. Sparse mode only.
+             */
+            template <Component T>
+            void removeFrom(Pool<T>& pool, const Entity& entity) {
+                pool.remove(entity);
+                mask(entity).reset(getID<T>());
+            }
+
             /**
              * @brief Removes a component from a given entity.
              * @tparam T The component type.
@@ -64,9 +133,71 @@ namespace iodine::core {
              */
             template <Component T>
             void remove(const Entity& entity) {
+                if (mode == Mode::Archetype) {
+                    archetypes.remove(entity, Info::of<T>(getID<T>()));
+                    return;
+                }
                 getPool<T>()->remove(entity);
+                mask(entity).reset(getID<T>());
+            }
+
+            /**
+             * @brief Checks whether an entity has all of the given components with a single mask comparison.
+             * @tparam Ts The component types.
+             * @param entity The entity to check.
+             * @return True if the entity has every component, false otherwise.
+             * @warning This function is not thread-safe.
+             */
+            template <Component... Ts>
+            b8 has(const Entity& entity) {
+                return getMask(entity).includes(Types::signatureOf<Ts...>());
             }
 
+            /**
+             * @brief Gets the set of components an entity has.
+             * @param entity The entity.
+             * @return The entity's component mask. Empty for entities without components.
+             * @warning This function is not thread-safe.
+             */
+            const Signature& getMask(const Entity& entity) const noexcept {
+                static const Signature empty;
+                if (mode == Mode::Archetype) {
+                    const Archetype::Table* table = archetypes.getTable(entity);
+                    return table ? table->getSignature() : empty;
+                }
+                return entity.getIndex() < masks.size() ? masks[entity.getIndex()] : empty;
+            }
+
+            /**
+             * @brief Removes every component of an entity. In sparse mode only the pools in the entity's mask are touched.
+             * @param entity The entity to clear.
+             * @warning This function is not thread-safe.
+             */
+            void destroy(const Entity& entity) {
+                if (mode == Mode::Archetype) {
+                    archetypes.destroy(entity);
+                    return;
+                }
+                if (entity.getIndex() >= masks.size()) return;
+                Signature& signature = masks[entity.getIndex()];
+                signature.forEach([&](u64 id) { table[id].load(std::memory_order_relaxed)->erase(entity); });
+                signature.clear();
+            }
+
+            inline Mode getMode() const noexcept { return mode; }
+
+            /**
+             * @brief Gets the component masks of every entity, by entity index. Indices past the end have no components.
+             * @return The masks (sparse mode).
+             */
+            inline const std::vector<Signature>& getMasks() const noexcept { return masks; }
+
+            /**
+             * @brief Gets the archetype tables of this registry.
+             * @return The archetype registry. Empty unless the registry runs in archetype mode.
+             */
+            inline Archetype::Registry& getArchetypes() noexcept { return archetypes; }
+
             /**
              * @brief Gets the component for the given entity.
              * @tparam T The component type to get.
@@ -76,6 +207,9 @@ namespace iodine::core {
              */
             template <Component T>
             T& get(const Entity& entity) {
+                if (mode == Mode::Archetype) {
+                    return archetypes.get<T>(entity, getID<T>());
+                }
                 return getPool<T>()->get(entity);
             }
 
@@ -88,69 +222,252 @@ namespace iodine::core {
              */
             template <Component T>
             const T& get(const Entity& entity) const {
-                return getPool<T>()->get(entity);
+                Registry* self = const_cast<Registry*>(this);
+                if (mode == Mode::Archetype) {
+                    return self->archetypes.get<T>(entity, getID<T>());
+                }
+                return std::as_const(*self->getPool<T>()).get(entity);
             }
 
-            private:
-            mutable std::shared_mutex idsLock;                                            ///< Ensure thread-safe access to the IDs map.
-            std::unordered_map<ID, std::unique_ptr<Storage>> store;                       ///< Storage for component pools.
-            std::unordered_map<std::string, ID, TransparentSVHash, std::equal_to<>> ids;  ///< Maps component names to their IDs.
-            std::atomic_uint32_t nextId{0};                                               ///< The next available ID for a component.
+            /**
+             * @brief Gets the clock used to stamp component changes.
+             * @return The change-detection clock.
+             */
+            inline Clock& getClock() noexcept { return clock; }
+            inline const Clock& getClock() const noexcept { return clock; }
 
             /**
-             * @brief Gets the component ID for the given component type.
-             * @tparam T The component type to get the ID for.
-             * @return The ID of the component type.
-             * @note This function is thread-safe.
+             * @brief Forgets removals recorded before the given tick in every pool.
+             * @param before The oldest tick to keep.
+             * @warning This function is not thread-safe.
              */
-            template <Component T>
-            ID getID() {
-                static std::string_view name = Reflect::reflect<T>().getType().getName();
-                static constinit std::atomic<ID> cached{std::numeric_limits<ID>::max()};
-
-                ID id = cached.load(std::memory_order_acquire);
-                if (id != std::numeric_limits<ID>::max()) return id;
-
-                {
-                    std::shared_lock readLock(idsLock);
-                    auto it = ids.find(name);
-                    if (it != ids.end()) {
-                        id = it->second;
-                        cached.store(id, std::memory_order_release);
-                        return id;
-                    }
+            void trimRemoved(Tick before) {
+                for (const Unique<Storage>& storage : pools) storage->trimRemoved(before);
+            }
+
+            /**
+             * @brief Writes every pool to a snapshot, keyed by the identity hash of its component type.
+             * @param out The snapshot writer.
+             * @throws Exception::Type::NotSupported in archetype mode, or if a component type cannot be serialized.
+             * @warning This function is not thread-safe.
+             */
+            void save(Snapshot::Writer& out) const {
+                if (mode == Mode::Archetype) {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Snapshots require sparse component storage");
+                }
+                out.write<u64>(pools.size());
+                for (const Unique<Storage>& storage : pools) {
+                    out.write<u64>(storage->getHash());
+                    storage->save(out);
                 }
+            }
 
-                std::unique_lock writeLock(idsLock);
+            /**
+             * @brief Replaces every component with the ones in a snapshot. Pools are filled in one pass and masks rebuilt.
+             * @param in The snapshot reader.
+             * @param limit Entity indices must be smaller than this: the number of slots of the loaded entity registry.
+             * @throws Exception::Type::NotFound if the snapshot holds a component type this registry has no pool for.
+             *         Register components with enter() before loading into a fresh registry.
+             * @throws Exception::Type::NotSupported in archetype mode.
+             * @warning This function is not thread-safe.
+             */
+            void load(Snapshot::Reader& in, u64 limit) {
+                if (mode == Mode::Archetype) {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Snapshots require sparse component storage");
+                }
+                std::unordered_map<u64, std::pair<ID, Storage*>> byHash;
+                for (ID id = 0; id < Capacity; id++) {
+                    Storage* storage = table[id].load(std::memory_order_relaxed);
+                    if (!storage) continue;
+                    storage->clear();
+                    byHash.emplace(storage->getHash(), std::make_pair(id, storage));
+                }
+                masks.clear();
 
-                auto it = ids.find(name);
-                if (it != ids.end()) {
-                    id = it->second;
-                } else {
-                    id = nextId++;
-                    ids.emplace(std::string(name), id);
-                    store.emplace(id, std::make_unique<Pool<T>>());
+                const u64 count = in.read<u64>();
+                for (u64 i = 0; i < count; i++) {
+                    const auto found = byHash.find(in.read<u64>());
+                    if (found == byHash.end()) {
+                        THROW_CORE_EXCEPTION(Exception::Type::NotFound, "Snapshot holds a component type that is not registered");
+                    }
+                    const auto [id, storage] = found->second;
+                    for (const u64 index : storage->load(in, limit)) {
+                        if (index >= masks.size()) masks.resize(index + 1);
+                        masks[index].set(id);
+                    }
                 }
+            }
+
+            /**
+             * @brief Replaces every component with a copy of another registry's components. Pools are copied array by
+             *        array, reusing capacity, and trivially copyable data is copied in bulk. Groups are packed again.
+             * @param other The registry to copy.
+             * @param dirtyOnly Skip pools that neither registry changed since one was last copied from the other.
+             *                  Changes are tracked like change detection, so writes through getAt() or find() are missed.
+             * @throws Exception::Type::NotSupported in archetype mode.
+             * @warning This function is not thread-safe.
+             */
+            void copyFrom(const Registry& other, b8 dirtyOnly = false) {
+                assertCopyable(other);
+                if (this == &other) return;
+
+                std::vector<b8> copied(Capacity, false);
+                for (ID id = 0; id < Capacity; id++) copied[id] = copyPool(id, other, dirtyOnly);
+                masks = other.masks;
+                clock.follow(other.clock);
+                refreshGroups(copied);
+            }
 
-                cached.store(id, std::memory_order_release);
-                return id;
+            /**
+             * @brief Copies the pools of some component types from another registry, like copyFrom() restricted to them.
+             *        The bits of the copied types are updated in the entity masks; other bits are kept.
+             * @tparam Ts The component types to copy.
+             * @param other The registry to copy from.
+             * @param dirtyOnly Skip pools that neither registry changed since one was last copied from the other.
+             * @throws Exception::Type::NotSupported in archetype mode.
+             * @warning This function is not thread-safe.
+             */
+            template <Component... Ts>
+            void copyPools(const Registry& other, b8 dirtyOnly = false) {
+                assertCopyable(other);
+                if (this == &other) return;
+
+                std::vector<b8> copied(Capacity, false);
+                ((copied[getID<Ts>()] = copyPool(getID<Ts>(), other, dirtyOnly)), ...);
+                ((copied[getID<Ts>()] ? syncMasks<Ts>() : void()), ...);
+                clock.follow(other.clock);
+                refreshGroups(copied);
             }
 
             /**
-             * @brief Fetches the concrete pool for the given component type.
+             * @brief Fetches the concrete pool for the given component type, creating it on first use.
              * @tparam T The component type to fetch the pool for.
              * @return The pool for the given component type.
-             * @note This function is thread-safe.
+             * @note This function is thread-safe. Lookups of existing pools are a single indexed load.
              */
             template <Component T>
             Pool<T>* getPool() {
-                static Pool<T>* cache = [this] {
-                    ID id = getID<T>();
-                    std::shared_lock readLock(idsLock);
-                    auto it = store.find(id);
-                    return static_cast<Pool<T>*>(it->second.get());
-                }();
-                return cache;
+                const ID id = getID<T>();
+                Storage* storage = table[id].load(std::memory_order_acquire);
+                if (storage) [[likely]] {
+                    return static_cast<Pool<T>*>(storage);
+                }
+
+                std::lock_guard lock(poolsLock);
+                storage = table[id].load(std::memory_order_relaxed);
+                if (!storage) {
+                    storage = pools.emplace_back(MakeUnique<Pool<T>>(clock)).get();
+                    table[id].store(storage, std::memory_order_release);
+                }
+                return static_cast<Pool<T>*>(storage);
+            }
+
+            /**
+             * @brief Gets the group owning the pools of the given component types, creating it on first use.
+             * @tparam Ts The owned component types, at least two.
+             * @param entities The entity registry used to resolve entity versions.
+             * @return The group.
+             * @throws Exception::Type::InvalidArgument if one of the pools is owned by another group.
+             * @throws Exception::Type::NotSupported in archetype mode.
+             * @warning This function is not thread-safe.
+             */
+            template <Component... Ts>
+            Group<Ts...>& group(const Entity::Registry& entities) {
+                if (mode == Mode::Archetype) {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Groups require sparse component storage");
+                }
+                for (const Unique<GroupBase>& existing : groups) {
+                    if (Group<Ts...>* match = dynamic_cast<Group<Ts...>*>(existing.get())) return *match;
+                }
+                auto created = MakeUnique<Group<Ts...>>(entities, getPool<Ts>()...);
+                Group<Ts...>& result = *created;
+                groups.push_back(std::move(created));
+                return result;
+            }
+
+            private:
+            Mode mode;                                 ///< The storage layout of this registry.
+            Archetype::Registry archetypes;            ///< Archetype tables, used in archetype mode.
+            Clock clock;                               ///< Stamps component changes (sparse mode).
+            std::vector<Signature> masks;              ///< The components of every entity, by index (sparse mode).
+            std::vector<std::atomic<Storage*>> table;  ///< Pools indexed by component ID, Capacity entries, never reallocated.
+            std::vector<Unique<Storage>> pools;        ///< Owns the pools, in creation order.
+            std::mutex poolsLock;                      ///< Serializes pool creation.
+            std::vector<Unique<GroupBase>> groups;     ///< Groups owning some of the pools, destroyed before them.
+
+            /**
+             * @brief Gets the mask of an entity, growing the mask array if needed.
+             */
+            inline Signature& mask(const Entity& entity) {
+                if (entity.getIndex() >= masks.size()) masks.resize(entity.getIndex() + 1);
+                return masks[entity.getIndex()];
+            }
+
+            /**
+             * @brief Rejects copies involving an archetype registry.
+             */
+            void assertCopyable(const Registry& other) const {
+                if (mode == Mode::Archetype || other.mode == Mode::Archetype) {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Copying requires sparse component storage");
+                }
+            }
+
+            /**
+             * @brief Copies one pool from another registry, creating it here if needed.
+             * @return True if the pool's contents were replaced.
+             */
+            b8 copyPool(ID id, const Registry& other, b8 dirtyOnly) {
+                const Storage* source = other.table[id].load(std::memory_order_acquire);
+                Storage* target = table[id].load(std::memory_order_relaxed);
+                if (!source) {
+                    if (target) target->clear();
+                    return target != nullptr;
+                }
+                if (!target) {
+                    std::lock_guard lock(poolsLock);
+                    target = pools.emplace_back(source->makeEmpty(clock)).get();
+                    table[id].store(target, std::memory_order_release);
+                }
+                if (dirtyOnly && target->isSyncedWith(*source)) return false;
+                target->copyFrom(*source);
+                return true;
+            }
+
+            /**
+             * @brief Sets the bit of a component type in exactly the masks of the entities its pool holds.
+             */
+            template <Component T>
+            void syncMasks() {
+                const ID id = getID<T>();
+                const Pool<T>& pool = *getPool<T>();
+                for (Signature& signature : masks) signature.reset(id);
+                for (u64 position = 0; position < pool.getSize(); position++) {
+                    const u64 index = pool.getIndices()[position];
+                    if (index >= masks.size()) masks.resize(index + 1);
+                    masks[index].set(id);
+                }
+            }
+
+            /**
+             * @brief Packs again every group owning a pool whose contents were replaced.
+             */
+            void refreshGroups(const std::vector<b8>& copied) {
+                for (const Unique<GroupBase>& group : groups) {
+                    b8 stale = false;
+                    group->getSignature().forEach([&](u64 id) { stale = stale || copied[id]; });
+                    if (stale) group->refresh();
+                }
+            }
+
+            /**
+             * @brief Gets the component ID for the given component type.
+             * @tparam T The component type to get the ID for.
+             * @return The ID of the component type, shared by every registry in the process.
+             * @note This function is thread-safe.
+             */
+            template <Component T>
+            static inline ID getID() {
+                return Types::of<T>();
             }
         };
     }  // namespace Component
@@ -1,20 +1,221 @@
 #pragma once
 
+#include <atomic>
+#include <span>
+
+#include "container/bitset.hpp"
+#include "ecs/entity/entity.hpp"
 #include "reflection/reflect.hpp"
 
 namespace iodine::core {
+    namespace Snapshot {
+        class Writer;
+        class Reader;
+    }  // namespace Snapshot
+
     namespace Component {
         template <typename T>
         concept Component = std::copy_constructible<T> && requires { Reflect::reflect<T>(); };
 
         using ID = u32;
 
+        /**
+         * @brief A set of component IDs. Identifies an archetype or the components held by an entity.
+         */
+        using Signature = BitSet<u64, 256>;
+
+        /**
+         * @brief How a registry lays out component data in memory.
+         */
+        enum class Mode {
+            Sparse,    ///< One sparse set per component type. Cheap structural changes, scattered multi-component iteration.
+            Archetype  ///< One table per distinct component set, with a contiguous column per component. Entities move between tables.
+        };
+
+        /**
+         * @brief Opts a component type into chunked pool storage: components live in 16 KiB, 64-byte-aligned chunks
+         *        that never move as the pool grows, instead of one array that is reallocated and copied. Specialize it
+         *        to true for large pools filled in bursts. Chunked types cannot be owned by groups that expose raw data.
+         * @tparam T The component type.
+         */
+        template <typename T>
+        inline constexpr b8 Chunked = false;
+
+        /**
+         * @brief Type-erased layout and lifetime operations of a component type.
+         */
+        struct IO_API Info {
+            ID id;                                     ///< The component ID.
+            u64 size;                                  ///< The size of the component in bytes.
+            u64 alignment;                             ///< The alignment of the component in bytes.
+            void (*copy)(void* dst, const void* src);  ///< Copy-constructs a component into uninitialized memory.
+            void (*move)(void* dst, void* src);        ///< Move-constructs a component into uninitialized memory.
+            void (*destroy)(void* ptr);                ///< Destroys a component in place.
+
+            /**
+             * @brief Builds the info for a component type.
+             * @tparam T The component type.
+             * @param id The ID assigned to the component type.
+             * @return The component info.
+             */
+            template <Component T>
+            static Info of(ID id) {
+                return Info{
+                    id,
+                    sizeof(T),
+                    alignof(T),
+                    [](void* dst, const void* src) { new (dst) T(*static_cast<const T*>(src)); },
+                    [](void* dst, void* src) { new (dst) T(std::move(*static_cast<T*>(src))); },
+                    [](void* ptr) { static_cast<T*>(ptr)->~T(); },
+                };
+            }
+        };
+
+        /**
+         * @brief A point in a registry's change-detection timeline. Ticks only grow; zero means "never". 64 bits wide,
+         *        so the counter cannot wrap in practice and comparisons need no wrap handling.
+         */
+        using Tick = u64;
+
+        /**
+         * @brief The ticks at which a component was added and last mutably accessed.
+         */
+        struct IO_API Stamp {
+            Tick added;    ///< The tick the component was inserted at.
+            Tick changed;  ///< The tick the component was last accessed mutably (or inserted) at.
+        };
+
+        /**
+         * @brief Hands out change-detection ticks. Every system run takes a fresh tick, so a system sees exactly the
+         *        changes stamped after its previous run started, excluding its own writes.
+         */
+        class IO_API Clock {
+            public:
+            /**
+             * @brief Makes the calling thread stamp changes with a system's tick and read changes since its last run.
+             */
+            class Scope {
+                public:
+                Scope(Tick tick, Tick since) noexcept : previousTick(current), previousSince(reference) {
+                    current = tick;
+                    reference = since;
+                }
+                ~Scope() noexcept {
+                    current = previousTick;
+                    reference = previousSince;
+                }
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+
+                private:
+                Tick previousTick;   ///< The tick of the enclosing scope.
+                Tick previousSince;  ///< The reference tick of the enclosing scope.
+            };
+
+            /**
+             * @brief Takes a fresh tick for a system run.
+             * @return A tick that is greater than every tick handed out before.
+             */
+            inline Tick advance() noexcept { return tick.fetch_add(1, std::memory_order_acq_rel); }
+
+            /**
+             * @brief Gets the tick changes made by the calling thread are stamped with.
+             * @return The running system's tick, or the latest tick outside of systems.
+             */
+            inline Tick now() const noexcept { return current ? current : tick.load(std::memory_order_acquire); }
+
+            /**
+             * @brief Gets the tick change filters compare against on the calling thread.
+             * @return The tick the running system last ran at, or zero (everything counts as changed) outside of systems.
+             */
+            static inline Tick since() noexcept { return reference; }
+
+            /**
+             * @brief Moves this clock forward to another clock's tick, if it is behind. Used when copying stamps over.
+             * @param other The other clock.
+             */
+            inline void follow(const Clock& other) noexcept {
+                const Tick theirs = other.tick.load(std::memory_order_acquire);
+                Tick mine = tick.load(std::memory_order_relaxed);
+                while (mine < theirs && !tick.compare_exchange_weak(mine, theirs, std::memory_order_acq_rel)) {
+                }
+            }
+
+            private:
+            std::atomic<Tick> tick{1};                      ///< The next tick to hand out.
+            static inline thread_local Tick current = 0;    ///< The running system's tick on this thread, if any.
+            static inline thread_local Tick reference = 0;  ///< The running system's previous tick on this thread.
+        };
+
         /**
          * @brief Acts as an interface for the storage of components.
          */
         class IO_API Storage {
             public:
             virtual ~Storage() = default;
+
+            /**
+             * @brief Removes an entity's component, if it has one, without knowing the component type.
+             * @param entity The entity.
+             */
+            virtual void erase(const Entity& entity) = 0;
+
+            /**
+             * @brief Forgets removals recorded before the given tick.
+             * @param before The oldest tick to keep.
+             */
+            virtual void trimRemoved(Tick before) = 0;
+
+            /**
+             * @brief Removes every component and forgets recorded removals.
+             */
+            virtual void clear() = 0;
+
+            /**
+             * @brief Gets the identity hash of the stored component type, stable across processes of the same build.
+             * @return The hash, as computed by Types::hash.
+             */
+            virtual u64 getHash() const noexcept = 0;
+
+            /**
+             * @brief Writes the entity indices and components of this storage to a snapshot.
+             *        Trivially copyable components are written as one block, others field by field.
+             * @param out The snapshot writer.
+             * @throws Exception::Type::NotSupported if the component type cannot be serialized.
+             */
+            virtual void save(Snapshot::Writer& out) const = 0;
+
+            /**
+             * @brief Reads components written by save() into this storage, which must be empty, in one pass.
+             * @param in The snapshot reader.
+             * @param limit Entity indices must be smaller than this: the number of slots of the loaded entity registry.
+             * @return The entity indices that received a component.
+             * @throws Exception::Type::NotSupported if the component type cannot be serialized.
+             * @throws Exception::Type::InvalidArgument if the snapshot is truncated, repeats an index or holds an index
+             *         past the limit.
+             */
+            virtual std::span<const u64> load(Snapshot::Reader& in, u64 limit) = 0;
+
+            /**
+             * @brief Creates an empty storage of the same component type.
+             * @param clock The clock of the registry that will own the new storage.
+             * @return The new storage.
+             */
+            virtual Unique<Storage> makeEmpty(const Clock& clock) const = 0;
+
+            /**
+             * @brief Replaces the contents of this storage with a copy of another one of the same component type.
+             *        Dense, sparse and data arrays reuse their capacity; trivially copyable data is copied in bulk.
+             * @param other The storage to copy.
+             */
+            virtual void copyFrom(const Storage& other) = 0;
+
+            /**
+             * @brief Checks whether neither storage changed since one was last copied from the other.
+             * @param other A storage of the same component type.
+             * @return True if both still hold equal contents.
+             */
+            virtual b8 isSyncedWith(const Storage& other) const noexcept = 0;
         };
     }  // namespace Component
-}  // namespace iodine::core
\ No newline at end of file
+}  // namespace iodine::core
@@ -0,0 +1,47 @@
+#include "ecs/component/types.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "debug/exception.hpp"
+#include "debug/log.hpp"
+
+namespace iodine::core {
+    namespace Component {
+        /**
+         * @brief A type registered with the table.
+         */
+        struct Entry {
+            ID id;             ///< The assigned dense ID.
+            std::string name;  ///< The reflected name, kept to report collisions.
+        };
+
+        static std::mutex typesLock;                   ///< Guards the hash table.
+        static std::unordered_map<u64, Entry> entries;  ///< Maps type hashes to their IDs.
+
+        ID Types::assign(u64 hash, std::string_view name) {
+            std::lock_guard lock(typesLock);
+            auto it = entries.find(hash);
+            if (it == entries.end()) {
+                if (entries.size() >= Capacity) {
+                    IO_ERROR("Cannot register %.*s: all %llu component type IDs are taken", static_cast<int>(name.size()), name.data(), static_cast<unsigned long long>(Capacity));
+                    THROW_CORE_EXCEPTION(Exception::Type::OutOfMemory, "Too many component types");
+                }
+                const ID id = static_cast<ID>(entries.size());
+                entries.emplace(hash, Entry{id, std::string(name)});
+                return id;
+            }
+            if (it->second.name != name) {
+                IO_ERROR("Component type hash collision between %s and %.*s", it->second.name.c_str(), static_cast<int>(name.size()), name.data());
+                THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Component type hash collision");
+            }
+            return it->second.id;
+        }
+
+        u32 Types::getCount() {
+            std::lock_guard lock(typesLock);
+            return static_cast<u32>(entries.size());
+        }
+    }  // namespace Component
+}  // namespace iodine::core
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <string_view>
+
+#include "ecs/component/storage.hpp"
+
+namespace iodine::core {
+    namespace Component {
+        /**
+         * @brief The process-wide table assigning component IDs to component types.
+         *        Every type has a compile-time identity hash, derived from the compiler's signature of a function template
+         *        instantiated for it. Dense IDs are assigned once per process from that hash, so every registry indexes its
+         *        pools with the same IDs; two types hashing alike are reported when the second one registers.
+         */
+        class IO_API Types {
+            public:
+            static constexpr u64 Capacity = 1024;  ///< Maximum number of component types a process can assign IDs to.
+
+            /**
+             * @brief Computes the identity hash of a type at compile time.
+             * @tparam T The type.
+             * @return The 64-bit FNV-1a hash of the compiler's signature for this function, which names T.
+             */
+            template <typename T>
+            static consteval u64 hash() {
+#ifdef _MSC_VER
+                return fnv(__FUNCSIG__);
+#else
+                return fnv(__PRETTY_FUNCTION__);
+#endif
+            }
+
+            /**
+             * @brief Gets the compiler's signature naming a type, for types that are not reflected.
+             * @tparam T The type.
+             * @return The signature of this function, which names T. Distinct types have distinct signatures.
+             */
+            template <typename T>
+            static constexpr std::string_view signature() {
+#ifdef _MSC_VER
+                return __FUNCSIG__;
+#else
+                return __PRETTY_FUNCTION__;
+#endif
+            }
+
+            /**
+             * @brief Gets the ID of a component type, assigning the next free ID on first use.
+             * @param hash The identity hash of the component type.
+             * @param name The reflected name of the component type, used to report collisions.
+             * @return The ID of the component type.
+             * @throws Exception::Type::InvalidArgument if another type with the same hash was already assigned.
+             * @throws Exception::Type::OutOfMemory if Capacity types were already assigned.
+             * @note This function is thread-safe.
+             */
+            static ID assign(u64 hash, std::string_view name);
+
+            /**
+             * @brief Counts the component types assigned so far.
+             * @return The number of assigned IDs.
+             * @note This function is thread-safe.
+             */
+            static u32 getCount();
+
+            /**
+             * @brief Gets the ID of a component type.
+             * @tparam T The component type.
+             * @return The ID of the component type. Resolved once per type and process.
+             * @note This function is thread-safe.
+             */
+            template <Component T>
+            static ID of() {
+                static const ID id = assign(hash<T>(), Reflect::reflect<T>().getType().getName());
+                return id;
+            }
+
+            /**
+             * @brief Gets the signature of a set of component types.
+             * @tparam Ts The component types.
+             * @return The signature, built once per type list and process.
+             * @note This function is thread-safe.
+             */
+            template <Component... Ts>
+            static const Signature& signatureOf() {
+                static const Signature signature = [] {
+                    Signature bits;
+                    (bits.set(of<Ts>()), ...);
+                    return bits;
+                }();
+                return signature;
+            }
+
+            private:
+            /**
+             * @brief Hashes a null-terminated string with 64-bit FNV-1a.
+             */
+            static constexpr u64 fnv(const char* text) {
+                u64 h = 0xcbf29ce484222325ull;
+                for (; *text; text++) {
+                    h ^= static_cast<u8>(*text);
+                    h *= 0x100000001b3ull;
+                }
+                return h;
+            }
+        };
+    }  // namespace Component
+}  // namespace iodine::core
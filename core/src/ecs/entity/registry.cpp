@@ -1,37 +1,210 @@
 #include "ecs/entity/registry.hpp"
 
+#include "debug/exception.hpp"
+#include "ecs/snapshot/snapshot.hpp"
+
 namespace iodine::core {
 
-    Entity::Registry::Registry() : next(0), available(0) {}
+    Entity::Registry::Registry() : cursor(0), head(0) {
+        for (std::atomic<Directory>& directory : directories) directory.store(nullptr, std::memory_order_relaxed);
+    }
+
+    Entity::Registry::~Registry() {
+        for (std::atomic<Directory>& entry : directories) {
+            const Directory directory = entry.load(std::memory_order_relaxed);
+            if (!directory) continue;
+            for (u64 page = 0; page < DirectorySize; page++) delete[] directory[page].load(std::memory_order_relaxed);
+            delete[] directory;
+        }
+    }
 
     Entity Entity::Registry::create() {
-        std::unique_lock lock(entitiesLock);
+        // Same as allocate(1, ...), without the run and output vectors.
+        u64 current = head.load(std::memory_order_acquire);
+        while (current & LinkMask) {
+            const u64 index = (current & LinkMask) - 1;
+            const std::atomic<ID>* entry = find(index);
+            if (!entry) break;
+            const u64 next = (((current >> TagShift) + 1) << TagShift) | getIndex(entry->load(std::memory_order_acquire));
+            if (head.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire)) {
+                std::atomic<ID>& popped = slot(index);
+                ID id = popped.load(std::memory_order_relaxed);
+                setIndex(id, index);
+                popped.store(id, std::memory_order_release);
+                return Entity(id);
+            }
+        }
+
+        const u64 index = claim(1);
+        const ID id = static_cast<ID>(index << 16);
+        slot(index).store(id, std::memory_order_release);
+        return Entity(id);
+    }
+
+    void Entity::Registry::allocate(u64 count, std::vector<ID>& created) {
+        created.reserve(created.size() + count);
 
-        if (available == 0) {
-            const u64 index = entities.size();
-            entities.emplace_back(static_cast<ID>(index << 16));
-            return Entity(entities.back());
+        // Pop a run of up to count recycled indices. The walk may read links that concurrent pops rewrite, but then the
+        // tag has changed and the exchange fails.
+        std::vector<u64> run;
+        u64 current = head.load(std::memory_order_acquire);
+        while (true) {
+            run.clear();
+            u64 link = current & LinkMask;
+            while (link != 0 && run.size() < count) {
+                const std::atomic<ID>* entry = find(link - 1);
+                if (!entry) break;
+                run.push_back(link - 1);
+                link = getIndex(entry->load(std::memory_order_acquire));
+            }
+            if (run.empty()) break;
+            const u64 next = (((current >> TagShift) + 1) << TagShift) | link;
+            if (head.compare_exchange_weak(current, next, std::memory_order_acq_rel, std::memory_order_acquire)) break;
+        }
+        for (u64 index : run) {
+            std::atomic<ID>& entry = slot(index);
+            ID id = entry.load(std::memory_order_relaxed);
+            setIndex(id, index);
+            entry.store(id, std::memory_order_release);
+            created.push_back(id);
         }
 
-        const u64 index = next;
-        next = getIndex(entities[index]);
-        setIndex(entities[index], index);
-        available--;
-        return Entity(entities[index]);
+        const u64 fresh = count - run.size();
+        if (fresh == 0) return;
+        const u64 first = claim(fresh);
+        for (u64 index = first; index < first + fresh; index++) {
+            const ID id = static_cast<ID>(index << 16);
+            slot(index).store(id, std::memory_order_release);
+            created.push_back(id);
+        }
     }
 
-    void Entity::Registry::destroy(Entity entity) {
-        std::unique_lock lock(entitiesLock);
+    u64 Entity::Registry::claim(u64 count) {
+        u64 first = cursor.load(std::memory_order_relaxed);
+        do {
+            if (first + count > MaxIndices || first + count >= LinkMask) {
+                THROW_CORE_EXCEPTION(Exception::Type::OutOfMemory, "Entity registry is full: every 32-bit index was handed out");
+            }
+        } while (!cursor.compare_exchange_weak(first, first + count, std::memory_order_relaxed));
+        assure(first, first + count);
+        return first;
+    }
+
+    void Entity::Registry::assure(u64 first, u64 last) {
+        for (u64 page = first / PageSize; page <= (last - 1) / PageSize; page++) {
+            std::atomic<Directory>& entry = directories[page / DirectorySize];
+            Directory directory = entry.load(std::memory_order_acquire);
+            if (!directory) {
+                Directory fresh = new std::atomic<Page>[DirectorySize];
+                for (u64 i = 0; i < DirectorySize; i++) fresh[i].store(nullptr, std::memory_order_relaxed);
+                if (entry.compare_exchange_strong(directory, fresh, std::memory_order_acq_rel)) {
+                    directory = fresh;
+                } else {
+                    delete[] fresh;
+                }
+            }
 
+            std::atomic<Page>& pageEntry = directory[page % DirectorySize];
+            if (pageEntry.load(std::memory_order_acquire)) continue;
+            Page fresh = new std::atomic<ID>[PageSize];
+            for (u64 i = 0; i < PageSize; i++) fresh[i].store(0, std::memory_order_relaxed);
+            Page expected = nullptr;
+            if (!pageEntry.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) delete[] fresh;
+        }
+    }
+
+    b8 Entity::Registry::kill(ID id) noexcept {
+        std::atomic<ID>* entry = const_cast<std::atomic<ID>*>(find(getIndex(id)));
+        if (!entry) return false;
+        ID dead = id;
+        setIndex(dead, 0);
+        setVersion(dead, getVersion(id) + 1);
+        return entry->compare_exchange_strong(id, dead, std::memory_order_acq_rel);
+    }
+
+    void Entity::Registry::push(u64 first, u64 last) noexcept {
+        u64 current = head.load(std::memory_order_acquire);
+        do {
+            link(last, current & LinkMask);
+        } while (!head.compare_exchange_weak(current, (((current >> TagShift) + 1) << TagShift) | (first + 1), std::memory_order_acq_rel,
+                                             std::memory_order_acquire));
+    }
+
+    void Entity::Registry::destroy(Entity entity) {
+        if (!kill(entity.id)) return;
         const u64 index = getIndex(entity.id);
-        setIndex(entities[index], next);
-        setVersion(entities[index], getVersion(entities[index]) + 1);
-        next = index;
-        available++;
+        push(index, index);
+    }
+
+    void Entity::Registry::destroyBatch(std::span<const Entity> batch) {
+        // Link the killed entities into one run (links store index + 1), then splice it onto the free list.
+        u64 first = 0;
+        u64 last = 0;
+        b8 any = false;
+        for (const Entity& entity : batch) {
+            if (!kill(entity.id)) continue;
+            const u64 index = getIndex(entity.id);
+            if (any) {
+                link(last, index + 1);
+            } else {
+                first = index;
+            }
+            last = index;
+            any = true;
+        }
+        if (any) push(first, last);
+    }
+
+    void Entity::Registry::save(Snapshot::Writer& out) const {
+        const u64 count = cursor.load(std::memory_order_acquire);
+        std::vector<ID> slots(count);
+        for (u64 index = 0; index < count; index++) slots[index] = slot(index).load(std::memory_order_relaxed);
+        out.write<u64>(count);
+        out.write<u64>(head.load(std::memory_order_relaxed));
+        out.write(slots.data(), count * sizeof(ID));
     }
 
-    b8 Entity::Registry::isAlive(Entity entity) const {
-        std::shared_lock lock(entitiesLock);
-        return getVersion(entities[getIndex(entity.id)]) == getVersion(entity.id);
+    void Entity::Registry::load(Snapshot::Reader& in) {
+        const u64 count = in.read<u64>();
+        const u64 first = in.read<u64>();
+        if (count > MaxIndices || count > in.getRemaining() / sizeof(ID) || (first & LinkMask) > count) {
+            THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Snapshot holds a malformed entity registry");
+        }
+        std::vector<ID> slots(count);
+        in.read(slots.data(), count * sizeof(ID));
+
+        if (count) assure(0, count);
+        for (u64 index = 0; index < count; index++) slot(index).store(slots[index], std::memory_order_relaxed);
+        retire(count);
+        cursor.store(count, std::memory_order_relaxed);
+        head.store(first, std::memory_order_release);
+    }
+
+    void Entity::Registry::copyFrom(const Registry& other) {
+        if (this == &other) return;
+        const u64 count = other.cursor.load(std::memory_order_acquire);
+        if (count) assure(0, count);
+        for (u64 page = 0; page * PageSize < count; page++) {
+            const Page source = other.findPage(page);
+            const Page target = findPage(page);
+            for (u64 slot = 0; slot < std::min(PageSize, count - page * PageSize); slot++) {
+                target[slot].store(source[slot].load(std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+        retire(count);
+        cursor.store(count, std::memory_order_relaxed);
+        head.store(other.head.load(std::memory_order_relaxed), std::memory_order_release);
+    }
+
+    void Entity::Registry::retire(u64 count) noexcept {
+        // Indices from count onward were handed out after the copied state; they become fresh again.
+        for (u64 page = count / PageSize; page < DirectorySize * MaxDirectories; page++) {
+            const Page entries = findPage(page);
+            if (!entries) break;
+            for (u64 index = std::max(count, page * PageSize); index < (page + 1) * PageSize; index++) {
+                const ID id = entries[index % PageSize].load(std::memory_order_relaxed);
+                if (getIndex(id) == index) kill(id);
+            }
+        }
     }
-}  // namespace iodine::core
\ No newline at end of file
+}  // namespace iodine::core
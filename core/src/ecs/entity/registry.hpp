@@ -1,42 +1,206 @@
 #pragma once
 
-#include <shared_mutex>
+#include <atomic>
+#include <span>
+#include <vector>
 
 #include "ecs/entity/entity.hpp"
 
 namespace iodine::core {
+    namespace Snapshot {
+        class Writer;
+        class Reader;
+    }  // namespace Snapshot
 
     /**
-     * @brief Manages creation and destruction of entities.
+     * @brief Manages creation and destruction of entities without locks.
+     *        Entity slots live in fixed-size pages that never move, so readers can load them while other threads create
+     *        entities. Pages are reached through directory blocks that are also allocated on first use, so an empty
+     *        registry only holds the small top-level table. Fresh indices come from an atomic cursor; recycled ones from a version-tagged lock-free free list
+     *        threaded through the dead slots.
      */
     class IO_API Entity::Registry {
         public:
+        static constexpr u64 PageSize = 4096;       ///< Number of entity slots per page.
+        static constexpr u64 DirectorySize = 4096;  ///< Number of pages per directory block.
+        static constexpr u64 MaxDirectories = 256;  ///< Number of directory blocks, covering the 32-bit index range.
+        static constexpr u64 MaxIndices = PageSize * DirectorySize * MaxDirectories;  ///< Number of indices a registry can hand out.
+
         Registry();
-        ~Registry() = default;
+        ~Registry();
+        Registry(const Registry&) = delete;
+        Registry& operator=(const Registry&) = delete;
 
         /**
          * @brief Creates a new entity.
          * @return The ID of the new entity.
+         * @note This function is lock-free.
          */
         Entity create();
 
         /**
-         * @brief Destroys an entity.
+         * @brief Creates several entities at once. A run of recycled indices is spliced off the free list with a single
+         *        exchange, the remaining fresh indices are reserved with a single increment.
+         * @tparam OutputIt An output iterator accepting Entity.
+         * @param count The number of entities to create.
+         * @param out Receives the new entities.
+         * @return The output iterator past the last written entity.
+         * @note This function is lock-free.
+         */
+        template <typename OutputIt>
+        OutputIt createBatch(u64 count, OutputIt out) {
+            std::vector<ID> created;
+            allocate(count, created);
+            for (ID id : created) *out++ = Entity(id);
+            return out;
+        }
+
+        /**
+         * @brief Destroys an entity. Destroying an entity that is not alive does nothing.
          * @param entity The entity to destroy.
+         * @note This function is lock-free.
          */
         void destroy(Entity entity);
 
+        /**
+         * @brief Destroys several entities. The destroyed indices are linked into one run and spliced onto the free list
+         *        at once. Entities that are not alive are skipped.
+         * @param batch The entities to destroy.
+         * @note This function is lock-free.
+         */
+        void destroyBatch(std::span<const Entity> batch);
+
         /**
          * @brief Checks if an entity is alive.
          * @param entity The entity to check.
          * @return True if the entity is alive, false otherwise.
+         * @note This is a single acquire load.
          */
-        b8 isAlive(Entity entity) const;
+        b8 isAlive(Entity entity) const noexcept {
+            const std::atomic<ID>* entry = find(getIndex(entity.id));
+            return entry && getVersion(entry->load(std::memory_order_acquire)) == getVersion(entity.id);
+        }
+
+        /**
+         * @brief Gets the current entity stored at an index.
+         * @param index The entity index. Must have been handed out by create().
+         * @return The entity currently occupying the index.
+         */
+        inline Entity at(u64 index) const noexcept { return Entity(slot(index).load(std::memory_order_acquire)); }
+
+        /**
+         * @brief Gets the number of indices ever handed out. Every index below it has a slot, alive or dead.
+         * @return The number of slots.
+         */
+        inline u64 getSlotCount() const noexcept { return cursor.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Writes the allocator state to a snapshot: every slot ever handed out and the free list.
+         * @param out The snapshot writer.
+         * @warning This function is not thread-safe.
+         */
+        void save(Snapshot::Writer& out) const;
+
+        /**
+         * @brief Restores the allocator state written by save(). Entities alive at save time are alive again with the
+         *        same IDs, and entities created since then are dead.
+         * @param in The snapshot reader.
+         * @throws Exception::Type::InvalidArgument if the snapshot is truncated or malformed.
+         * @warning This function is not thread-safe.
+         */
+        void load(Snapshot::Reader& in);
+
+        /**
+         * @brief Makes this registry an exact copy of another one, reusing the pages already allocated.
+         * @param other The registry to copy.
+         * @warning This function is not thread-safe.
+         */
+        void copyFrom(const Registry& other);
 
         private:
-        mutable std::shared_mutex entitiesLock;  ///< Mutex for thread-safe access to the entity pool.
-        std::vector<u64> entities;               ///< The entity pool.
-        u64 next;                                ///< The next available entity index.
-        u64 available;                           ///< The number of available entities.
+        static constexpr u64 LinkMask = 0xFFFFFFFFull;  ///< Free-list head bits holding the first index plus one.
+        static constexpr u64 TagShift = 32;             ///< Free-list head bits holding the ABA tag.
+
+        using Page = std::atomic<ID>*;          ///< PageSize slots.
+        using Directory = std::atomic<Page>*;  ///< DirectorySize page pointers.
+
+        std::atomic<Directory> directories[MaxDirectories];  ///< Directory blocks, allocated on first use.
+        std::atomic<u64> cursor;                             ///< The next never-used entity index.
+        std::atomic<u64> head;                               ///< Free-list head: (tag << 32) | (index + 1), zero index part when empty.
+
+        /**
+         * @brief Gets a page, or nullptr if it was never allocated.
+         */
+        inline Page findPage(u64 page) const noexcept {
+            if (page >= DirectorySize * MaxDirectories) return nullptr;
+            const Directory directory = directories[page / DirectorySize].load(std::memory_order_acquire);
+            return directory ? directory[page % DirectorySize].load(std::memory_order_acquire) : nullptr;
+        }
+
+        /**
+         * @brief Gets the slot of an index whose page exists.
+         */
+        inline std::atomic<ID>& slot(u64 index) const noexcept {
+            const u64 page = index / PageSize;
+            return directories[page / DirectorySize].load(std::memory_order_acquire)[page % DirectorySize].load(
+                std::memory_order_acquire)[index % PageSize];
+        }
+
+        /**
+         * @brief Gets the slot of an index, or nullptr if it was never handed out.
+         */
+        inline const std::atomic<ID>* find(u64 index) const noexcept {
+            const Page page = findPage(index / PageSize);
+            return page ? &page[index % PageSize] : nullptr;
+        }
+
+        /**
+         * @brief Kills the entities at indices from count onward, after the slots below count were overwritten.
+         */
+        void retire(u64 count) noexcept;
+
+        /**
+         * @brief Makes sure the directory blocks and pages holding [first, last) exist.
+         */
+        void assure(u64 first, u64 last);
+
+        /**
+         * @brief Pops up to count recycled indices off the free list and reserves fresh ones for the rest.
+         * @param count The number of entities to create.
+         * @param created Receives the IDs of the created entities.
+         */
+        void allocate(u64 count, std::vector<ID>& created);
+
+        /**
+         * @brief Reserves a range of never-used indices and makes sure their pages exist. The cursor only moves if
+         *        the whole range fits.
+         * @param count The number of indices.
+         * @return The first reserved index.
+         * @throws Exception::Type::OutOfMemory if the range would reach past MaxIndices.
+         */
+        u64 claim(u64 count);
+
+        /**
+         * @brief Marks a slot dead if it still holds the given entity.
+         * @return True if this call killed the entity.
+         */
+        b8 kill(ID id) noexcept;
+
+        /**
+         * @brief Splices a linked run of dead slots onto the free list.
+         * @param first The first index of the run.
+         * @param last The last index of the run, whose link is overwritten with the current head.
+         */
+        void push(u64 first, u64 last) noexcept;
+
+        /**
+         * @brief Overwrites the free-list link stored in a dead slot, keeping its version.
+         */
+        inline void link(u64 index, u64 next) noexcept {
+            std::atomic<ID>& entry = slot(index);
+            ID id = entry.load(std::memory_order_relaxed);
+            setIndex(id, next);
+            entry.store(id, std::memory_order_release);
+        }
     };
-}  // namespace iodine::core
\ No newline at end of file
+}  // namespace iodine::core
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "prelude.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Type-erased interface of an event queue, so a world can advance all of its queues.
+     */
+    class IO_API EventsBase {
+        public:
+        virtual ~EventsBase() = default;
+
+        /**
+         * @brief Publishes the events staged by every thread, in thread order.
+         * @warning Not thread-safe. Called at sync points.
+         */
+        virtual void flush() = 0;
+
+        /**
+         * @brief Drops the older buffer and starts a new one. Events live for two updates.
+         * @warning Not thread-safe. Called once per update.
+         */
+        virtual void swap() = 0;
+
+        protected:
+        static inline std::atomic<u64> nextSerial{1};  ///< Serial numbers of queues, never reused.
+    };
+
+    /**
+     * @brief A double-buffered queue of events of one type.
+     *        Writers append to a buffer owned by their thread without locking; staged events are published at sync
+     *        points into two contiguous buffers that are swapped every update. Readers keep a cursor (a sequence number),
+     *        so each reader sees every event exactly once as long as it reads at least once per update.
+     * @tparam T The event type.
+     */
+    template <typename T>
+    class IO_API Events : public EventsBase {
+        public:
+        /**
+         * @brief A reader's position in the event stream.
+         */
+        class Reader {
+            public:
+            Reader() = default;
+
+            private:
+            friend class Events;
+            u64 cursor = 0;  ///< The sequence number of the next event to read.
+        };
+
+        Events() : serial(nextSerial.fetch_add(1, std::memory_order_relaxed)) {}
+        ~Events() override = default;
+        Events(const Events&) = delete;
+        Events& operator=(const Events&) = delete;
+
+        /**
+         * @brief Sends an event. It becomes readable after the next sync point.
+         * @param event The event.
+         * @note This function is thread-safe. After the first call on a thread it does not lock.
+         */
+        void send(T event) { local().push_back(std::move(event)); }
+
+        /**
+         * @brief Calls a function for every published event the reader has not seen yet, oldest first.
+         * @tparam Function Invocable with const T&.
+         * @param reader The reader's cursor, advanced past the last event.
+         * @param function The function to call.
+         * @note Any number of readers may read concurrently, but not while events are published.
+         */
+        template <typename Function>
+        void read(Reader& reader, Function&& function) const {
+            const u64 previousBase = base - buffers[older].size();
+            if (reader.cursor < previousBase) reader.cursor = previousBase;
+            for (u64 sequence = reader.cursor; sequence < previousBase + getCount(); sequence++) {
+                function(sequence < base ? buffers[older][sequence - previousBase] : buffers[1 - older][sequence - base]);
+            }
+            reader.cursor = base + buffers[1 - older].size();
+        }
+
+        /**
+         * @brief Creates a reader that only sees events published from now on.
+         * @return The reader.
+         */
+        Reader latest() const {
+            Reader reader;
+            reader.cursor = base + buffers[1 - older].size();
+            return reader;
+        }
+
+        /**
+         * @brief Counts the published events still held in both buffers.
+         * @return The number of readable events.
+         */
+        inline u64 getCount() const noexcept { return buffers[0].size() + buffers[1].size(); }
+
+        void flush() override {
+            std::vector<T>& current = buffers[1 - older];
+            for (auto& [thread, staged] : staging) {
+                current.insert(current.end(), std::make_move_iterator(staged->begin()), std::make_move_iterator(staged->end()));
+                staged->clear();
+            }
+        }
+
+        void swap() override {
+            base += buffers[1 - older].size();
+            older = 1 - older;
+            buffers[1 - older].clear();
+        }
+
+        private:
+        const u64 serial;                                                     ///< Identifies this queue in thread-local caches.
+        std::vector<T> buffers[2];                                            ///< The older and the current published events.
+        u64 older = 0;                                                        ///< Which buffer holds the older events.
+        u64 base = 0;                                                         ///< The sequence number of the first current event.
+        std::mutex stagingLock;                                               ///< Protects the staging map.
+        std::unordered_map<std::thread::id, Unique<std::vector<T>>> staging;  ///< One staging buffer per writing thread.
+
+        /**
+         * @brief Gets the staging buffer of the calling thread, creating it on first use.
+         */
+        std::vector<T>& local() {
+            struct Cache {
+                u64 serial = 0;
+                std::vector<T>* buffer = nullptr;
+            };
+            static thread_local Cache cache;
+            if (cache.serial == serial) return *cache.buffer;
+
+            std::lock_guard lock(stagingLock);
+            Unique<std::vector<T>>& buffer = staging[std::this_thread::get_id()];
+            if (!buffer) buffer = MakeUnique<std::vector<T>>();
+            cache = {serial, buffer.get()};
+            return *buffer;
+        }
+    };
+}  // namespace iodine::core
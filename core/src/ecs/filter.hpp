@@ -0,0 +1,150 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+
+#include "ecs/component/storage.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief View term matching entities that have component T, without passing T to the view's function.
+     *        Empty component types (tags) listed in a view are turned into this term automatically.
+     * @tparam T The component type.
+     */
+    template <Component::Component T>
+    struct With {
+        using Type = T;
+    };
+
+    /**
+     * @brief View term matching entities whose component T was added since the running system last ran.
+     *        Outside of systems every component counts as added. The term does not pass T to the view's function.
+     * @tparam T The component type.
+     */
+    template <Component::Component T>
+    struct Added {
+        using Type = T;
+    };
+
+    /**
+     * @brief View term matching entities whose component T was added or mutably accessed since the running system last
+     *        ran. Outside of systems every component counts as changed. The term does not pass T to the view's function.
+     * @tparam T The component type.
+     */
+    template <Component::Component T>
+    struct Changed {
+        using Type = T;
+    };
+
+    /**
+     * @brief View term matching entities that do not have component T.
+     * @tparam T The component type.
+     */
+    template <Component::Component T>
+    struct Without {
+        using Type = T;
+    };
+
+    /**
+     * @brief View term passing a pointer to component T to the view's function, or nullptr if the entity has none.
+     *        It does not restrict which entities match. Const-qualify T for read-only access.
+     * @tparam T The component type.
+     */
+    template <typename T>
+        requires Component::Component<std::remove_const_t<T>>
+    struct Optional {
+        using Type = T;
+    };
+
+    namespace Filter {
+        /**
+         * @brief Whether a view term filters entities instead of passing a component to the view's function.
+         */
+        template <typename T>
+        inline constexpr b8 IsFilter = false;
+        template <typename T>
+        inline constexpr b8 IsFilter<With<T>> = true;
+        template <typename T>
+        inline constexpr b8 IsFilter<Added<T>> = true;
+        template <typename T>
+        inline constexpr b8 IsFilter<Changed<T>> = true;
+        template <typename T>
+        inline constexpr b8 IsFilter<Without<T>> = true;
+
+        /**
+         * @brief Whether a filter term depends on change stamps, which only sparse storage keeps.
+         */
+        template <typename F>
+        inline constexpr b8 IsChange = std::is_same_v<F, Added<typename F::Type>> || std::is_same_v<F, Changed<typename F::Type>>;
+
+        /**
+         * @brief Whether a filter term excludes the entities that have its component.
+         */
+        template <typename F>
+        inline constexpr b8 IsExclusion = std::is_same_v<F, Without<typename F::Type>>;
+
+        /**
+         * @brief Whether a view component term is Optional<T>.
+         */
+        template <typename T>
+        inline constexpr b8 IsOptional = false;
+        template <typename T>
+        inline constexpr b8 IsOptional<Optional<T>> = true;
+
+        /**
+         * @brief The possibly const-qualified component type of a view component term.
+         */
+        template <typename T>
+        struct Target {
+            using Type = T;
+        };
+        template <typename T>
+        struct Target<Optional<T>> {
+            using Type = T;
+        };
+
+        /**
+         * @brief What a view passes for a component term: a reference, or a pointer for Optional<T>.
+         */
+        template <typename T>
+        using Ref = std::conditional_t<IsOptional<T>, typename Target<T>::Type*, T&>;
+
+        /**
+         * @brief Turns a view term into a filter term: tags become With<T>, other terms are kept.
+         */
+        template <typename T>
+        using AsFilter = std::conditional_t<IsFilter<T>, T, With<std::remove_const_t<T>>>;
+
+        /**
+         * @brief Checks a component's change stamp against a filter term.
+         * @tparam F The filter term.
+         * @param stamp The stamp of the component.
+         * @param since The tick the running system last ran at.
+         * @return True if the component passes the filter.
+         */
+        template <typename F>
+        inline b8 passes(const Component::Stamp& stamp, Component::Tick since) noexcept {
+            if constexpr (std::is_same_v<F, With<typename F::Type>>) {
+                return true;
+            } else if constexpr (std::is_same_v<F, Added<typename F::Type>>) {
+                return stamp.added > since;
+            } else {
+                return stamp.changed > since;
+            }
+        }
+
+        /**
+         * @brief Splits view terms into component types and filter terms, preserving their order. Tags (empty component
+         *        types) go to the filters as With<T>; Optional<T> terms stay with the component types.
+         */
+        template <typename C, typename F, typename... Terms>
+        struct Split {
+            using Components = C;  ///< std::tuple of the component types.
+            using Filters = F;     ///< std::tuple of the filter terms.
+        };
+        template <typename... Cs, typename... Fs, typename T, typename... Rest>
+        struct Split<std::tuple<Cs...>, std::tuple<Fs...>, T, Rest...>
+            : std::conditional_t<IsFilter<T> || (std::is_empty_v<T> && !IsOptional<T>), Split<std::tuple<Cs...>, std::tuple<Fs..., AsFilter<T>>, Rest...>,
+                                 Split<std::tuple<Cs..., T>, std::tuple<Fs...>, Rest...>> {};
+    }  // namespace Filter
+}  // namespace iodine::core
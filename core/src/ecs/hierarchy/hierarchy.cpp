@@ -0,0 +1,135 @@
+#include "ecs/hierarchy/hierarchy.hpp"
+
+namespace iodine::core {
+    Hierarchy::Hierarchy(const Entity::Registry& entities, Component::Registry& components) : entities(entities), components(components) {}
+
+    void Hierarchy::setParent(const Entity& child, const Entity& parent) {
+        if (child == parent) {
+            THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "An entity cannot be its own parent");
+        }
+        Component::Pool<Parent>* links = components.getPool<Parent>();
+
+        // Walk up from the new parent; meeting the child means the parent is one of its descendants.
+        for (const Parent* link = links->find(parent.getIndex()); link; link = links->find(link->index)) {
+            if (entities.at(link->index).getVersion() != link->version) break;
+            if (link->index == child.getIndex()) {
+                THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Parenting an entity to one of its descendants would create a cycle");
+            }
+        }
+
+        const Parent link{parent.getIndex(), parent.getVersion()};
+        if (links->find(child.getIndex())) {
+            links->get(child) = link;
+        } else {
+            components.emplaceInto(*links, child, link);
+        }
+    }
+
+    void Hierarchy::clearParent(const Entity& child) {
+        Component::Pool<Parent>* links = components.getPool<Parent>();
+        if (links->find(child.getIndex())) components.removeFrom(*links, child);
+    }
+
+    void Hierarchy::propagate() {
+        if (components.getMode() == Component::Mode::Archetype) {
+            THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Transform propagation requires sparse component storage");
+        }
+        Component::Pool<Transform>* locals = components.getPool<Transform>();
+        Component::Pool<GlobalTransform>* globals = components.getPool<GlobalTransform>();
+        const Component::Pool<Parent>* links = components.getPool<Parent>();
+
+        const Component::Tick since = lastPropagated;
+        lastPropagated = components.getClock().advance();
+
+        const b8 rebuilt = !valid || isStale(*locals, *links);
+        if (rebuilt) rebuild(*locals, *globals, *links);
+
+        // Both pools are normally laid out in node order; fall back to a lookup when a later sort or group moved them.
+        const u64* localIndices = locals->getIndices();
+        const u64* globalIndices = globals->getIndices();
+        auto localAt = [&](u64 node) { return localIndices[node] == indices[node] ? node : locals->getPosition(indices[node]); };
+        auto globalAt = [&](u64 node) { return globalIndices[node] == indices[node] ? node : globals->getPosition(indices[node]); };
+
+        globals->touch();
+        const Component::Tick now = components.getClock().now();
+        for (u64 node = 0; node < indices.size(); node++) {
+            const u64 local = localAt(node);
+            const u32 parent = parents[node];
+            dirty[node] = rebuilt || locals->getStampAt(local).changed > since || (parent != Root && dirty[parent]);
+            if (!dirty[node]) continue;
+
+            const u64 global = globalAt(node);
+            const Transform& transform = locals->getAt(local);
+            Transform& result = globals->getAt(global);
+            result = parent == Root ? transform : globals->getAt(globalAt(parent)).compose(transform);
+            globals->markChangedAt(global, now);
+        }
+    }
+
+    b8 Hierarchy::isStale(const Component::Pool<Transform>& locals, const Component::Pool<Parent>& links) const noexcept {
+        return locals.getMembership() != transformMembership || links.getRevision() != parentRevision;
+    }
+
+    void Hierarchy::rebuild(Component::Pool<Transform>& locals, Component::Pool<GlobalTransform>& globals, const Component::Pool<Parent>& links) {
+        // Every node gets a GlobalTransform; entities that lost their Transform lose it too.
+        for (u64 position = 0; position < locals.getSize(); position++) {
+            const u64 index = locals.getIndices()[position];
+            if (!globals.find(index)) components.emplaceInto(globals, entities.at(index));
+        }
+        for (u64 position = globals.getSize(); position-- > 0;) {
+            const u64 index = globals.getIndices()[position];
+            if (!locals.find(index)) components.removeFrom(globals, entities.at(index));
+        }
+
+        // Group children by parent (counting sort over Transform pool positions), then walk the forest breadth-first.
+        const u64 count = locals.getSize();
+        std::vector<u32> parentOf(count);
+        std::vector<u32> first(count + 1, 0);
+        for (u64 position = 0; position < count; position++) {
+            parentOf[position] = resolve(locals, links.find(locals.getIndices()[position]));
+            if (parentOf[position] != Root) first[parentOf[position] + 1]++;
+        }
+        for (u64 position = 0; position < count; position++) first[position + 1] += first[position];
+        std::vector<u32> children(first[count]);
+        std::vector<u32> fill(first.begin(), first.end() - 1);
+        for (u64 position = 0; position < count; position++) {
+            if (parentOf[position] != Root) children[fill[parentOf[position]]++] = static_cast<u32>(position);
+        }
+
+        std::vector<u32> positions;
+        positions.reserve(count);
+        indices.clear();
+        parents.clear();
+        for (u64 position = 0; position < count; position++) {
+            if (parentOf[position] != Root) continue;
+            positions.push_back(static_cast<u32>(position));
+            parents.push_back(Root);
+        }
+        for (u64 node = 0; node < positions.size(); node++) {
+            const u32 position = positions[node];
+            for (u32 child = first[position]; child < first[position + 1]; child++) {
+                positions.push_back(children[child]);
+                parents.push_back(static_cast<u32>(node));
+            }
+        }
+        if (positions.size() < count) {
+            IO_WARN("%llu entities are parented in a cycle and skipped by transform propagation", static_cast<unsigned long long>(count - positions.size()));
+        }
+        indices.resize(positions.size());
+        for (u64 node = 0; node < positions.size(); node++) indices[node] = locals.getIndices()[positions[node]];
+        dirty.assign(indices.size(), 0);
+
+        // Lay out both pools in node order so the sweep walks them linearly. Pools owned by a group keep their order.
+        if (!locals.getOwner().group) locals.sortAs(indices);
+        if (!globals.getOwner().group) globals.sortAs(indices);
+
+        transformMembership = locals.getMembership();
+        parentRevision = links.getRevision();
+        valid = true;
+    }
+
+    u32 Hierarchy::resolve(const Component::Pool<Transform>& locals, const Parent* link) const {
+        if (!link || entities.at(link->index).getVersion() != link->version || !locals.find(link->index)) return Root;
+        return static_cast<u32>(locals.getPosition(link->index));
+    }
+}  // namespace iodine::core
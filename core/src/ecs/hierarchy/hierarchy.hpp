@@ -0,0 +1,92 @@
+#pragma once
+
+#include "ecs/component/registry.hpp"
+#include "ecs/hierarchy/transform.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Maintains parent/child relationships and propagates Transform into GlobalTransform.
+     *        Relationships live in the Parent pool. The hierarchy keeps a breadth-first flattened order of every entity
+     *        with a Transform, so propagation is one linear sweep in which parents come before their children, and it
+     *        lays the Transform and GlobalTransform pools out in that order. Only subtrees whose local transforms changed
+     *        since the previous propagation are recomputed; a rebuild of the order recomputes everything.
+     */
+    class IO_API Hierarchy {
+        public:
+        static constexpr u32 Root = std::numeric_limits<u32>::max();  ///< The parent slot of root nodes.
+
+        /**
+         * @brief Creates an empty hierarchy.
+         * @param entities The entity registry of the owning world.
+         * @param components The component registry of the owning world.
+         */
+        Hierarchy(const Entity::Registry& entities, Component::Registry& components);
+        ~Hierarchy() = default;
+        Hierarchy(const Hierarchy&) = delete;
+        Hierarchy(Hierarchy&&) = delete;
+        Hierarchy& operator=(const Hierarchy&) = delete;
+        Hierarchy& operator=(Hierarchy&&) = delete;
+
+        /**
+         * @brief Attaches an entity to a parent, replacing its previous parent.
+         * @param child The child entity.
+         * @param parent The parent entity.
+         * @throws Exception::Type::InvalidArgument if the parent is the child or one of its descendants.
+         */
+        void setParent(const Entity& child, const Entity& parent);
+
+        /**
+         * @brief Detaches an entity from its parent, making it a root.
+         * @param child The child entity.
+         */
+        void clearParent(const Entity& child);
+
+        /**
+         * @brief Recomputes the GlobalTransform of every entity whose Transform, or an ancestor's, changed since the
+         *        previous call. Entities with a Transform get a GlobalTransform; entities whose parent was destroyed
+         *        become roots. The flattened order is rebuilt when relationships or the set of transforms changed.
+         * @throws Exception::Type::NotSupported in archetype mode.
+         * @warning Not thread-safe. Run it from a system that writes Transform, GlobalTransform and Parent.
+         */
+        void propagate();
+
+        /**
+         * @brief Forces the next propagation to rebuild the order and recompute everything, e.g. after the world's
+         *        components were replaced wholesale.
+         */
+        inline void invalidate() noexcept { valid = false; }
+
+        /**
+         * @brief Gets the flattened order: entity indices sorted by depth, parents before children.
+         * @return The entity indices, valid until the next propagation.
+         */
+        inline const std::vector<u64>& getOrder() const noexcept { return indices; }
+
+        private:
+        const Entity::Registry& entities;    ///< The owning world's entities.
+        Component::Registry& components;     ///< The owning world's components.
+        std::vector<u64> indices;            ///< Entity indices in breadth-first order.
+        std::vector<u32> parents;            ///< The order slot of each node's parent, or Root.
+        std::vector<u8> dirty;               ///< Whether each node was recomputed in the current sweep.
+        u64 transformMembership = 0;         ///< The Transform pool's membership revision at the last rebuild.
+        u64 parentRevision = 0;              ///< The Parent pool's revision at the last rebuild.
+        b8 valid = false;                    ///< Cleared to force a rebuild.
+        Component::Tick lastPropagated = 0;  ///< The tick the previous propagation started at.
+
+        /**
+         * @brief Checks whether relationships or the set of transforms changed since the last rebuild, in constant time.
+         */
+        b8 isStale(const Component::Pool<Transform>& locals, const Component::Pool<Parent>& links) const noexcept;
+
+        /**
+         * @brief Rebuilds the flattened order, adds or drops GlobalTransforms and lays both pools out in that order.
+         */
+        void rebuild(Component::Pool<Transform>& locals, Component::Pool<GlobalTransform>& globals, const Component::Pool<Parent>& links);
+
+        /**
+         * @brief Resolves the node a link points at.
+         * @return The parent's position in the Transform pool, or Root if the link is dangling.
+         */
+        u32 resolve(const Component::Pool<Transform>& locals, const Parent* link) const;
+    };
+}  // namespace iodine::core
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "reflection/external/primitives.hpp"
+#include "reflection/traits/field.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief The local transform of an entity, relative to its parent (or to the world for roots).
+     */
+    struct IO_API Transform {
+        f32 x = 0.0f;      ///< Translation along X.
+        f32 y = 0.0f;      ///< Translation along Y.
+        f32 z = 0.0f;      ///< Translation along Z.
+        f32 qx = 0.0f;     ///< Rotation as a unit quaternion, X component.
+        f32 qy = 0.0f;     ///< Rotation as a unit quaternion, Y component.
+        f32 qz = 0.0f;     ///< Rotation as a unit quaternion, Z component.
+        f32 qw = 1.0f;     ///< Rotation as a unit quaternion, W component.
+        f32 scale = 1.0f;  ///< Uniform scale.
+
+        /**
+         * @brief Composes this transform with a child's local transform: scale, then rotate, then translate.
+         * @param child The child's transform, relative to this one.
+         * @return The child's transform relative to this transform's space.
+         */
+        Transform compose(const Transform& child) const noexcept {
+            // Rotate the scaled child translation by this rotation: v' = v + w t + q x t, with t = 2 q x v.
+            const f32 vx = child.x * scale, vy = child.y * scale, vz = child.z * scale;
+            const f32 tx = 2.0f * (qy * vz - qz * vy), ty = 2.0f * (qz * vx - qx * vz), tz = 2.0f * (qx * vy - qy * vx);
+
+            Transform result;
+            result.x = x + vx + qw * tx + (qy * tz - qz * ty);
+            result.y = y + vy + qw * ty + (qz * tx - qx * tz);
+            result.z = z + vz + qw * tz + (qx * ty - qy * tx);
+            result.qx = qw * child.qx + qx * child.qw + qy * child.qz - qz * child.qy;
+            result.qy = qw * child.qy - qx * child.qz + qy * child.qw + qz * child.qx;
+            result.qz = qw * child.qz + qx * child.qy - qy * child.qx + qz * child.qw;
+            result.qw = qw * child.qw - qx * child.qx - qy * child.qy - qz * child.qz;
+            result.scale = scale * child.scale;
+            return result;
+        }
+
+        IO_REFLECT;
+    };
+
+    /**
+     * @brief The transform of an entity relative to the world, computed by hierarchy propagation. Do not write it.
+     */
+    struct IO_API GlobalTransform : Transform {
+        IO_REFLECT;
+    };
+
+    /**
+     * @brief Links an entity to its parent. Set it through Hierarchy::setParent, which rejects cycles.
+     */
+    struct IO_API Parent {
+        u64 index;    ///< The parent's entity index.
+        u64 version;  ///< The parent's entity version, so a recycled index is not mistaken for the parent.
+
+        IO_REFLECT;
+    };
+}  // namespace iodine::core
+
+IO_REFLECT_IMPL(iodine::core::Transform, "iodine::core::Transform",
+                iodine::core::Fields()
+                    .with("x", &iodine::core::Transform::x)
+                    .with("y", &iodine::core::Transform::y)
+                    .with("z", &iodine::core::Transform::z)
+                    .with("qx", &iodine::core::Transform::qx)
+                    .with("qy", &iodine::core::Transform::qy)
+                    .with("qz", &iodine::core::Transform::qz)
+                    .with("qw", &iodine::core::Transform::qw)
+                    .with("scale", &iodine::core::Transform::scale));
+IO_REFLECT_IMPL(iodine::core::GlobalTransform, "iodine::core::GlobalTransform");
+IO_REFLECT_IMPL(iodine::core::Parent, "iodine::core::Parent",
+                iodine::core::Fields().with("index", &iodine::core::Parent::index).with("version", &iodine::core::Parent::version));
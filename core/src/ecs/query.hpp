@@ -0,0 +1,45 @@
+#pragma once
+
+#include "ecs/view.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief A view kept across calls, typically captured by a system. It resolves its pools and matches archetype
+     *        tables once, then only refreshes what can change: the smallest pool, the change reference of the running
+     *        system and the tables created since the previous call.
+     * @tparam Terms The view terms, as for View.
+     * @warning The query must not outlive the world it was created from.
+     */
+    template <typename... Terms>
+    class IO_API Query {
+        public:
+        /**
+         * @brief Creates a query over the given registries.
+         * @param entities The entity registry used to resolve entity versions.
+         * @param components The component registry holding the data.
+         */
+        Query(Entity::Registry& entities, Component::Registry& components) : view(entities, components) {}
+
+        /**
+         * @brief Gets the cached view, brought up to date. Use it for range-for loops and parallel iteration.
+         * @return The view, valid until the next structural change.
+         */
+        View<Terms...>& get() {
+            view.refresh();
+            return view;
+        }
+
+        /**
+         * @brief Calls a function for every matching entity, see BasicView::each().
+         * @tparam Function Invocable with (Entity, Ts&...) or (Ts&...), taking T* for Optional<T> terms.
+         * @param function The function to call.
+         */
+        template <typename Function>
+        void each(Function&& function) {
+            get().each(std::forward<Function>(function));
+        }
+
+        private:
+        View<Terms...> view;  ///< The cached view.
+    };
+}  // namespace iodine::core
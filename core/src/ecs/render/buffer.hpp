@@ -0,0 +1,48 @@
+#pragma once
+
+#include "concurrency/triple_buffer.hpp"
+#include "ecs/world.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Hands render-relevant component data from the tick thread to the render thread without locks.
+     *        The tick thread extracts the selected pools into a free frame and publishes it with one atomic exchange;
+     *        the render thread always reads the latest complete frame. Pools that did not change since a frame was last
+     *        filled are not copied again.
+     * @tparam Ts The component types to extract.
+     */
+    template <Component::Component... Ts>
+    class IO_API RenderBuffer {
+        public:
+        RenderBuffer() = default;
+        ~RenderBuffer() = default;
+        RenderBuffer(const RenderBuffer&) = delete;
+        RenderBuffer& operator=(const RenderBuffer&) = delete;
+
+        /**
+         * @brief Extracts the selected pools of a world into a free frame and publishes it.
+         * @param world The world, not being updated concurrently.
+         * @warning Tick thread only, typically at the end of Application::tick.
+         */
+        void publish(const World& world) {
+            world.extract<Ts...>(frames.getWriteBuffer());
+            frames.publish();
+        }
+
+        /**
+         * @brief Gets the latest published frame.
+         * @return The frame, which stays valid until the next call. Empty before the first publish.
+         * @warning Render thread only.
+         */
+        const RenderFrame& read() noexcept { return frames.read(); }
+
+        /**
+         * @brief Checks whether a frame was published since the last read().
+         * @return True if read() returns a new frame.
+         */
+        inline b8 hasUpdate() const noexcept { return frames.hasUpdate(); }
+
+        private:
+        TripleBuffer<RenderFrame> frames;  ///< The frames being filled, published and read.
+    };
+}  // namespace iodine::core
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "ecs/view.hpp"
+
+namespace iodine::core {
+    class World;
+
+    /**
+     * @brief A render-side copy of the component pools the renderer needs, extracted from a world by the tick thread.
+     *        Frames are recycled, so extraction reuses their capacity.
+     */
+    class IO_API RenderFrame {
+        public:
+        RenderFrame() = default;
+        ~RenderFrame() = default;
+        RenderFrame(const RenderFrame&) = delete;
+        RenderFrame& operator=(const RenderFrame&) = delete;
+
+        /**
+         * @brief Creates a view over the extracted components.
+         * @tparam Ts The component types, which should be const-qualified. Only extracted types hold data.
+         * @return The view.
+         */
+        template <typename... Ts>
+        View<Ts...> view() const {
+            return View<Ts...>(entities, components);
+        }
+
+        /**
+         * @brief Looks up an extracted component of an entity.
+         * @tparam T The component type.
+         * @param entity The entity.
+         * @return A pointer to the component, or nullptr if the entity had none when the frame was extracted.
+         */
+        template <Component::Component T>
+        const T* find(const Entity& entity) const {
+            return entities.isAlive(entity) ? components.getPool<T>()->find(entity.getIndex()) : nullptr;
+        }
+
+        /**
+         * @brief Gets the number of the world update the frame was extracted after.
+         * @return The update sequence number, zero for a frame that was never extracted.
+         */
+        inline u64 getSequence() const noexcept { return sequence; }
+
+        private:
+        friend class World;
+
+        mutable Entity::Registry entities;       ///< A copy of the world's entities.
+        mutable Component::Registry components;  ///< Copies of the extracted pools.
+        u64 sequence = 0;                        ///< The world update the frame was extracted after.
+    };
+}  // namespace iodine::core
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <vector>
+
+#include "debug/exception.hpp"
+#include "ecs/resource/types.hpp"
+
+namespace iodine::core {
+    namespace Resource {
+        /**
+         * @brief Holds one instance of each resource type (time, input state, settings, ...) in a dense array indexed by
+         *        resource ID, so lookups are a single indexed load.
+         */
+        class IO_API Registry {
+            public:
+            Registry() = default;
+            ~Registry() = default;
+            Registry(const Registry&) = delete;
+            Registry& operator=(const Registry&) = delete;
+
+            /**
+             * @brief Inserts or replaces a resource.
+             * @tparam T The resource type.
+             * @tparam Args The types of the arguments to forward to the resource constructor.
+             * @param ...args The arguments to forward to the resource constructor.
+             * @return The resource.
+             * @warning This function is not thread-safe.
+             */
+            template <typename T, typename... Args>
+            T& insert(Args&&... args) {
+                const ID id = Types::of<T>();
+                if (id >= slots.size()) slots.resize(id + 1);
+                auto holder = MakeUnique<Holder<T>>(std::forward<Args>(args)...);
+                T& value = holder->value;
+                slots[id] = std::move(holder);
+                return value;
+            }
+
+            /**
+             * @brief Removes a resource, if present.
+             * @tparam T The resource type.
+             * @warning This function is not thread-safe.
+             */
+            template <typename T>
+            void remove() {
+                const ID id = Types::of<T>();
+                if (id < slots.size()) slots[id].reset();
+            }
+
+            /**
+             * @brief Looks up a resource.
+             * @tparam T The resource type.
+             * @return A pointer to the resource, or nullptr if it was never inserted.
+             */
+            template <typename T>
+            inline T* find() noexcept {
+                const ID id = Types::of<T>();
+                return id < slots.size() && slots[id] ? &static_cast<Holder<T>*>(slots[id].get())->value : nullptr;
+            }
+
+            /**
+             * @brief Gets a resource.
+             * @tparam T The resource type.
+             * @return The resource, which must have been inserted.
+             */
+            template <typename T>
+            inline T& get() noexcept {
+                T* value = find<T>();
+                IO_ASSERT_MSG(value, "Resource was not inserted");
+                return *value;
+            }
+
+            private:
+            /**
+             * @brief Type-erased owner of a resource.
+             */
+            struct HolderBase {
+                virtual ~HolderBase() = default;
+            };
+
+            template <typename T>
+            struct Holder : HolderBase {
+                template <typename... Args>
+                explicit Holder(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+                T value;  ///< The resource.
+            };
+
+            std::vector<Unique<HolderBase>> slots;  ///< Resources indexed by resource ID.
+        };
+    }  // namespace Resource
+}  // namespace iodine::core
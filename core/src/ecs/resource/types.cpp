@@ -0,0 +1,38 @@
+#include "ecs/resource/types.hpp"
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "debug/exception.hpp"
+#include "debug/log.hpp"
+
+namespace iodine::core {
+    namespace Resource {
+        /**
+         * @brief A type registered with the table.
+         */
+        struct Entry {
+            ID id;             ///< The assigned dense ID.
+            std::string name;  ///< The signature naming the type, kept to report collisions.
+        };
+
+        static std::mutex typesLock;                   ///< Guards the hash table.
+        static std::unordered_map<u64, Entry> entries;  ///< Maps type hashes to their IDs.
+
+        ID Types::assign(u64 hash, std::string_view name) {
+            std::lock_guard lock(typesLock);
+            auto it = entries.find(hash);
+            if (it == entries.end()) {
+                const ID id = static_cast<ID>(entries.size());
+                entries.emplace(hash, Entry{id, std::string(name)});
+                return id;
+            }
+            if (it->second.name != name) {
+                IO_ERROR("Resource type hash collision between %s and %.*s", it->second.name.c_str(), static_cast<int>(name.size()), name.data());
+                THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Resource type hash collision");
+            }
+            return it->second.id;
+        }
+    }  // namespace Resource
+}  // namespace iodine::core
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "ecs/component/types.hpp"
+
+namespace iodine::core {
+    namespace Resource {
+        using ID = u32;
+
+        /**
+         * @brief A set of resource IDs, e.g. the resources a system accesses.
+         */
+        using Signature = BitSet<u64, 64>;
+
+        /**
+         * @brief The process-wide table assigning resource IDs to resource types. IDs are dense and separate from
+         *        component IDs, so every world indexes its resources with the same small IDs.
+         */
+        class IO_API Types {
+            public:
+            /**
+             * @brief Gets the ID of a resource type, assigning the next free ID on first use.
+             * @param hash The compile-time identity hash of the resource type.
+             * @param name The compiler's signature naming the resource type, used to report collisions.
+             * @return The ID of the resource type.
+             * @throws Exception::Type::InvalidArgument if another type with the same hash was already assigned.
+             * @note This function is thread-safe.
+             */
+            static ID assign(u64 hash, std::string_view name);
+
+            /**
+             * @brief Gets the ID of a resource type.
+             * @tparam T The resource type.
+             * @return The ID of the resource type. Resolved once per type and process.
+             * @note This function is thread-safe.
+             */
+            template <typename T>
+            static ID of() {
+                static const ID id = assign(Component::Types::hash<T>(), Component::Types::signature<T>());
+                return id;
+            }
+        };
+    }  // namespace Resource
+}  // namespace iodine::core
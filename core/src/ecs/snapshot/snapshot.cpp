@@ -0,0 +1,89 @@
+#include "ecs/snapshot/snapshot.hpp"
+
+#include <cstring>
+
+#include "reflection/external/primitives.hpp"
+#include "reflection/external/string.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Gets the size of a primitive type, or zero if the type is not a primitive.
+     */
+    static u64 primitiveSize(const Type& type) {
+        static const std::pair<const Type*, u64> primitives[] = {
+            {&Reflect::reflect<u8>().getType(), sizeof(u8)},   {&Reflect::reflect<u16>().getType(), sizeof(u16)},
+            {&Reflect::reflect<u32>().getType(), sizeof(u32)}, {&Reflect::reflect<u64>().getType(), sizeof(u64)},
+            {&Reflect::reflect<i8>().getType(), sizeof(i8)},   {&Reflect::reflect<i16>().getType(), sizeof(i16)},
+            {&Reflect::reflect<i32>().getType(), sizeof(i32)}, {&Reflect::reflect<i64>().getType(), sizeof(i64)},
+            {&Reflect::reflect<f32>().getType(), sizeof(f32)}, {&Reflect::reflect<f64>().getType(), sizeof(f64)},
+            {&Reflect::reflect<byte>().getType(), sizeof(byte)},
+        };
+        for (const auto& [primitive, size] : primitives) {
+            if (*primitive == type) return size;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Gets the fields of a type that is serialized field by field.
+     */
+    static const Fields& fieldsOf(const Type& type) {
+        if (!type.hasTrait<Fields>()) {
+            THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Type is neither trivially copyable nor reflects its Fields");
+        }
+        return type.getTrait<Fields>();
+    }
+
+    void Snapshot::Writer::write(const void* data, u64 size) {
+        const u64 first = bytes.size();
+        bytes.resize(first + size);
+        if (size) std::memcpy(bytes.data() + first, data, size);
+    }
+
+    void Snapshot::Writer::writeFields(const Type& type, const void* object) {
+        static const Type& string = Reflect::reflect<std::string>().getType();
+        for (const Field& field : fieldsOf(type)) {
+            const byte* value = static_cast<const byte*>(object) + field.getOffset();
+            const Type& fieldType = field.getType();
+            if (const u64 size = primitiveSize(fieldType)) {
+                write(value, size);
+            } else if (fieldType == string) {
+                const std::string& text = *reinterpret_cast<const std::string*>(value);
+                write<u64>(text.size());
+                write(text.data(), text.size());
+            } else {
+                writeFields(fieldType, value);
+            }
+        }
+    }
+
+    const byte* Snapshot::Reader::take(u64 size) {
+        if (size > bytes.size() - offset) {
+            THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Snapshot is truncated");
+        }
+        const byte* data = bytes.data() + offset;
+        offset += size;
+        return data;
+    }
+
+    void Snapshot::Reader::read(void* data, u64 size) {
+        const byte* source = take(size);
+        if (size) std::memcpy(data, source, size);
+    }
+
+    void Snapshot::Reader::readFields(const Type& type, void* object) {
+        static const Type& string = Reflect::reflect<std::string>().getType();
+        for (const Field& field : fieldsOf(type)) {
+            byte* value = static_cast<byte*>(object) + field.getOffset();
+            const Type& fieldType = field.getType();
+            if (const u64 size = primitiveSize(fieldType)) {
+                read(value, size);
+            } else if (fieldType == string) {
+                const u64 length = read<u64>();
+                reinterpret_cast<std::string*>(value)->assign(take(length), length);
+            } else {
+                readFields(fieldType, value);
+            }
+        }
+    }
+}  // namespace iodine::core
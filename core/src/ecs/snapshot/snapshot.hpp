@@ -0,0 +1,120 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "reflection/traits/field.hpp"
+
+namespace iodine::core {
+    namespace Snapshot {
+        constexpr u32 Magic = 0x4E534F49;  ///< "IOSN", the first bytes of every snapshot.
+        constexpr u32 Version = 1;         ///< The snapshot layout version, bumped on incompatible changes.
+
+        /**
+         * @brief Appends binary data to a growing snapshot buffer.
+         *        Values are written in native byte order; snapshots are meant for save games and rollback on one platform.
+         */
+        class IO_API Writer {
+            public:
+            Writer() = default;
+            ~Writer() = default;
+
+            /**
+             * @brief Appends raw bytes.
+             * @param data The bytes to append.
+             * @param size The number of bytes.
+             */
+            void write(const void* data, u64 size);
+
+            /**
+             * @brief Appends a trivially copyable value.
+             * @tparam T The value type.
+             * @param value The value.
+             */
+            template <typename T>
+            void write(const T& value) {
+                STATIC_ASSERT(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be written raw");
+                write(&value, sizeof(T));
+            }
+
+            /**
+             * @brief Appends an object field by field, following its reflected Fields. Primitive and std::string fields
+             *        are written directly, fields of reflected struct types recurse.
+             * @param type The reflected type of the object.
+             * @param object The object.
+             * @throws Exception::Type::NotSupported if the type has no Fields or a field type cannot be serialized.
+             */
+            void writeFields(const Type& type, const void* object);
+
+            /**
+             * @brief Hands over the written bytes, leaving the writer empty.
+             * @return The snapshot.
+             */
+            std::vector<byte> release() noexcept { return std::move(bytes); }
+
+            inline u64 getSize() const noexcept { return bytes.size(); }
+
+            private:
+            std::vector<byte> bytes;  ///< The bytes written so far.
+        };
+
+        /**
+         * @brief Reads binary data back from a snapshot buffer, in the order it was written.
+         */
+        class IO_API Reader {
+            public:
+            /**
+             * @brief Starts reading a snapshot.
+             * @param bytes The snapshot. Must outlive the reader.
+             */
+            explicit Reader(std::span<const byte> bytes) : bytes(bytes) {}
+            ~Reader() = default;
+
+            /**
+             * @brief Consumes bytes without copying them.
+             * @param size The number of bytes.
+             * @return A pointer to the bytes, which may be unaligned.
+             * @throws Exception::Type::InvalidArgument if the snapshot is truncated.
+             */
+            const byte* take(u64 size);
+
+            /**
+             * @brief Copies the next bytes out.
+             * @param data Receives the bytes.
+             * @param size The number of bytes.
+             * @throws Exception::Type::InvalidArgument if the snapshot is truncated.
+             */
+            void read(void* data, u64 size);
+
+            /**
+             * @brief Reads a trivially copyable value.
+             * @tparam T The value type.
+             * @return The value.
+             * @throws Exception::Type::InvalidArgument if the snapshot is truncated.
+             */
+            template <typename T>
+            T read() {
+                STATIC_ASSERT(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be read raw");
+                T value;
+                read(&value, sizeof(T));
+                return value;
+            }
+
+            /**
+             * @brief Reads an object written by Writer::writeFields into an existing object.
+             * @param type The reflected type of the object.
+             * @param object The object, whose fields are overwritten.
+             * @throws Exception::Type::NotSupported if the type has no Fields or a field type cannot be serialized.
+             * @throws Exception::Type::InvalidArgument if the snapshot is truncated.
+             */
+            void readFields(const Type& type, void* object);
+
+            inline b8 isDone() const noexcept { return offset == bytes.size(); }
+            inline u64 getRemaining() const noexcept { return bytes.size() - offset; }
+
+            private:
+            std::span<const byte> bytes;  ///< The snapshot.
+            u64 offset = 0;               ///< The number of bytes consumed.
+        };
+    }  // namespace Snapshot
+}  // namespace iodine::core
@@ -0,0 +1,398 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <unordered_map>
+
+#include "ecs/component/registry.hpp"
+
+namespace iodine::core {
+    namespace Spatial {
+        /**
+         * @brief A point in world space.
+         */
+        struct IO_API Point {
+            f32 x = 0.0f;  ///< X coordinate.
+            f32 y = 0.0f;  ///< Y coordinate.
+            f32 z = 0.0f;  ///< Z coordinate.
+        };
+
+        /**
+         * @brief A component that holds a world-space position in x, y and z members, such as Transform for worlds
+         *        without a hierarchy or GlobalTransform for worlds with one.
+         */
+        template <typename P>
+        concept Positioned = Component::Component<P> && requires(const P& p) {
+            { p.x } -> std::convertible_to<f32>;
+            { p.y } -> std::convertible_to<f32>;
+            { p.z } -> std::convertible_to<f32>;
+        };
+
+        /**
+         * @brief The type-independent interface of spatial grids, so a world can reset them all.
+         */
+        class IO_API GridBase {
+            public:
+            virtual ~GridBase() = default;
+
+            /**
+             * @brief Forces the next update to rebuild the grid from scratch, e.g. after the world's components were
+             *        replaced wholesale by a snapshot or a copy.
+             */
+            virtual void invalidate() noexcept = 0;
+        };
+
+        /**
+         * @brief A uniform grid over the entities that have a position component, for range, radius and k-nearest
+         *        queries. Cells are hashed, so the grid is unbounded and memory follows the occupied cells only. Each cell
+         *        stores the entity indices and a copy of their positions, so queries never touch the component pool.
+         *        The grid is maintained incrementally: update() moves only the entities whose position was added or
+         *        changed, and drops the ones whose position was removed, since the previous update.
+         * @tparam P The position component type.
+         */
+        template <Positioned P>
+        class IO_API Grid : public GridBase {
+            public:
+            /**
+             * @brief Creates an empty grid. Call update() to fill it.
+             * @param entities The entity registry of the owning world.
+             * @param components The component registry of the owning world.
+             * @param cellSize The edge length of a cell. Close to the typical query radius works best.
+             * @throws Exception::Type::InvalidArgument if the cell size is not positive.
+             */
+            Grid(const Entity::Registry& entities, Component::Registry& components, f32 cellSize)
+                : entities(entities), components(components), cellSize(cellSize), inverse(1.0f / cellSize) {
+                if (!(cellSize > 0.0f)) {
+                    THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Spatial grid cell size must be positive");
+                }
+            }
+            ~Grid() = default;
+            Grid(const Grid&) = delete;
+            Grid(Grid&&) = delete;
+            Grid& operator=(const Grid&) = delete;
+            Grid& operator=(Grid&&) = delete;
+
+            /**
+             * @brief Brings the grid up to date with the position pool. Only positions added or changed since the
+             *        previous update are re-binned; the first update, or the first after invalidate(), inserts all.
+             * @throws Exception::Type::NotSupported in archetype mode.
+             * @warning Not thread-safe. Run it from a system that reads P, after the systems that move entities.
+             */
+            void update() {
+                if (components.getMode() == Component::Mode::Archetype) {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Spatial indexing requires sparse component storage");
+                }
+                const Component::Pool<P>& pool = *components.template getPool<P>();
+                const Component::Tick since = lastUpdated;
+                lastUpdated = components.getClock().advance();
+
+                if (!valid) {
+                    clear();
+                    for (u64 position = 0; position < pool.getSize(); position++) move(pool.getIndices()[position], pool.getAt(position));
+                    valid = true;
+                    return;
+                }
+
+                pool.forEachRemoved(since, [&](const Entity& entity) {
+                    if (!pool.find(entity.getIndex())) erase(entity.getIndex());
+                });
+                for (u64 position = 0; position < pool.getSize(); position++) {
+                    const Component::Stamp& stamp = pool.getStampAt(position);
+                    if (stamp.changed > since || stamp.added > since) move(pool.getIndices()[position], pool.getAt(position));
+                }
+
+                // Removals older than the pool's log were missed; drop whatever the pool no longer holds.
+                if (count != pool.getSize()) {
+                    for (Cell& cell : cells) {
+                        for (u64 position = cell.entries.size(); position-- > 0;) {
+                            const u64 index = cell.entries[position].index;
+                            if (!pool.find(index)) erase(index);
+                        }
+                    }
+                }
+            }
+
+            inline void invalidate() noexcept override { valid = false; }
+
+            /**
+             * @brief Collects the entities inside an axis-aligned box.
+             * @param min The box corner with the smallest coordinates.
+             * @param max The box corner with the largest coordinates.
+             * @param out The entities are appended to it, in no particular order.
+             */
+            void queryBox(const Point& min, const Point& max, std::vector<Entity>& out) const {
+                forEachCell(cellOf(min), cellOf(max), [&](const Cell& cell) {
+                    for (const Entry& entry : cell.entries) {
+                        if (entry.x >= min.x && entry.x <= max.x && entry.y >= min.y && entry.y <= max.y && entry.z >= min.z && entry.z <= max.z) {
+                            out.push_back(entities.at(entry.index));
+                        }
+                    }
+                });
+            }
+
+            /**
+             * @brief Collects the entities within a distance of a point.
+             * @param center The center of the sphere.
+             * @param radius The radius of the sphere.
+             * @param out The entities are appended to it, in no particular order.
+             */
+            void queryRadius(const Point& center, f32 radius, std::vector<Entity>& out) const {
+                const f32 limit = radius * radius;
+                const Point min{center.x - radius, center.y - radius, center.z - radius};
+                const Point max{center.x + radius, center.y + radius, center.z + radius};
+                forEachCell(cellOf(min), cellOf(max), [&](const Cell& cell) {
+                    for (const Entry& entry : cell.entries) {
+                        if (distanceSquared(entry, center) <= limit) out.push_back(entities.at(entry.index));
+                    }
+                });
+            }
+
+            /**
+             * @brief Collects the k entities closest to a point. Cells are searched in growing rings around the point,
+             *        and the search stops once no unsearched cell can hold a closer entity or every entity was seen.
+             *        Once a ring would cover more cells than are occupied, the remaining occupied cells are scanned
+             *        directly, so the cost is bounded by the occupied cells rather than the extent of the world.
+             * @param center The point.
+             * @param k The number of entities to find.
+             * @param out The entities are appended to it, closest first. Fewer than k if the grid holds fewer.
+             * @param radius Entities farther away than this are ignored.
+             */
+            void queryNearest(const Point& center, u64 k, std::vector<Entity>& out, f32 radius = std::numeric_limits<f32>::infinity()) const {
+                if (k == 0 || count == 0) return;
+                const f32 limit = radius * radius;
+                const Coord origin = cellOf(center);
+                std::vector<std::pair<f32, u64>> best;  // Max-heap on distance, holding up to k candidates.
+                best.reserve(std::min(k, count));
+                u64 seen = 0;
+
+                auto visit = [&](const Cell& cell) {
+                    seen += cell.entries.size();
+                    for (const Entry& entry : cell.entries) {
+                        const f32 distance = distanceSquared(entry, center);
+                        if (distance > limit || (best.size() == k && distance >= best.front().first)) continue;
+                        if (best.size() == k) {
+                            std::ranges::pop_heap(best);
+                            best.pop_back();
+                        }
+                        best.emplace_back(distance, entry.index);
+                        std::ranges::push_heap(best);
+                    }
+                };
+
+                // Ring r holds the cells at Chebyshev distance r, whose entities are at least r - 1 cells away.
+                const i64 rings = std::max({origin.x - low.x, high.x - origin.x, origin.y - low.y, high.y - origin.y, origin.z - low.z, high.z - origin.z});
+                for (i64 ring = 0; ring <= rings && seen < count; ring++) {
+                    const f32 reach = static_cast<f32>(std::max<i64>(ring - 1, 0)) * cellSize;
+                    if (reach * reach > limit) break;
+                    if (best.size() == k && reach * reach >= best.front().first) break;
+
+                    const f64 outer = 2.0 * static_cast<f64>(ring) + 1.0;
+                    const f64 inner = std::max(outer - 2.0, 0.0);
+                    if (outer * outer * outer - inner * inner * inner > static_cast<f64>(cells.size())) {
+                        for (const Cell& cell : cells) {
+                            const i64 distance = std::max({std::abs(cell.coord.x - origin.x), std::abs(cell.coord.y - origin.y), std::abs(cell.coord.z - origin.z)});
+                            if (distance >= ring && !cell.entries.empty()) visit(cell);
+                        }
+                        break;
+                    }
+                    forEachShellCell(origin, ring, visit);
+                }
+
+                std::ranges::sort_heap(best);
+                for (const auto& [distance, index] : best) out.push_back(entities.at(index));
+            }
+
+            /**
+             * @brief Gets the number of entities in the grid.
+             * @return The number of entities.
+             */
+            inline u64 getSize() const noexcept { return count; }
+
+            inline f32 getCellSize() const noexcept { return cellSize; }
+
+            private:
+            static constexpr u32 None = std::numeric_limits<u32>::max();  ///< The cell of untracked entities.
+            static constexpr i64 Bias = 1ll << 20;                        ///< Offset making 21-bit cell coordinates unsigned.
+
+            /**
+             * @brief Integer cell coordinates.
+             */
+            struct Coord {
+                i64 x;  ///< Cell X.
+                i64 y;  ///< Cell Y.
+                i64 z;  ///< Cell Z.
+            };
+
+            /**
+             * @brief A tracked entity and its position when it was last binned.
+             */
+            struct Entry {
+                u64 index;  ///< The entity index.
+                f32 x;      ///< X coordinate.
+                f32 y;      ///< Y coordinate.
+                f32 z;      ///< Z coordinate.
+            };
+
+            /**
+             * @brief The entities inside one cell.
+             */
+            struct Cell {
+                Coord coord;                 ///< The cell coordinates.
+                std::vector<Entry> entries;  ///< The entities, unordered.
+            };
+
+            /**
+             * @brief Where a tracked entity lives.
+             */
+            struct Slot {
+                u32 cell = None;   ///< The cell, or None if the entity is not tracked.
+                u32 position = 0;  ///< The entry position within the cell.
+            };
+
+            const Entity::Registry& entities;     ///< The owning world's entities.
+            Component::Registry& components;      ///< The owning world's components.
+            f32 cellSize;                         ///< The edge length of a cell.
+            f32 inverse;                          ///< One over the cell size.
+            std::vector<Cell> cells;              ///< Every cell that was ever occupied.
+            std::unordered_map<u64, u32> lookup;  ///< Packed cell coordinates to position in cells.
+            std::vector<Slot> slots;              ///< Per entity index, where it is tracked.
+            Coord low{0, 0, 0};                   ///< The smallest coordinates of an occupied cell so far.
+            Coord high{-1, -1, -1};               ///< The largest coordinates of an occupied cell so far.
+            u64 count = 0;                        ///< The number of tracked entities.
+            b8 valid = false;                     ///< Cleared to force a rebuild.
+            Component::Tick lastUpdated = 0;      ///< The tick the previous update started at.
+
+            /**
+             * @brief Computes the cell containing a point, clamped to the representable range.
+             */
+            template <typename T>
+            Coord cellOf(const T& point) const noexcept {
+                auto axis = [this](f32 value) {
+                    const f32 cell = std::floor(value * inverse);
+                    return static_cast<i64>(std::clamp(cell, static_cast<f32>(1 - Bias), static_cast<f32>(Bias - 1)));
+                };
+                return {axis(point.x), axis(point.y), axis(point.z)};
+            }
+
+            static inline u64 pack(const Coord& coord) noexcept {
+                return static_cast<u64>(coord.x + Bias) << 42 | static_cast<u64>(coord.y + Bias) << 21 | static_cast<u64>(coord.z + Bias);
+            }
+
+            static inline f32 distanceSquared(const Entry& entry, const Point& point) noexcept {
+                const f32 dx = entry.x - point.x, dy = entry.y - point.y, dz = entry.z - point.z;
+                return dx * dx + dy * dy + dz * dz;
+            }
+
+            /**
+             * @brief Calls a function for every occupied cell within an inclusive range of cell coordinates. Ranges
+             *        larger than the number of occupied cells are answered by scanning those cells instead.
+             */
+            template <typename Function>
+            void forEachCell(Coord from, Coord to, Function&& function) const {
+                from = {std::max(from.x, low.x), std::max(from.y, low.y), std::max(from.z, low.z)};
+                to = {std::min(to.x, high.x), std::min(to.y, high.y), std::min(to.z, high.z)};
+                if (from.x > to.x || from.y > to.y || from.z > to.z) return;
+
+                const f64 volume = static_cast<f64>(to.x - from.x + 1) * static_cast<f64>(to.y - from.y + 1) * static_cast<f64>(to.z - from.z + 1);
+                if (volume > static_cast<f64>(cells.size())) {
+                    for (const Cell& cell : cells) {
+                        const Coord& at = cell.coord;
+                        const b8 inside = at.x >= from.x && at.x <= to.x && at.y >= from.y && at.y <= to.y && at.z >= from.z && at.z <= to.z;
+                        if (inside && !cell.entries.empty()) function(cell);
+                    }
+                    return;
+                }
+                for (i64 x = from.x; x <= to.x; x++) {
+                    for (i64 y = from.y; y <= to.y; y++) {
+                        for (i64 z = from.z; z <= to.z; z++) {
+                            const auto found = lookup.find(pack({x, y, z}));
+                            if (found != lookup.end() && !cells[found->second].entries.empty()) function(cells[found->second]);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Calls a function for every occupied cell at exactly a Chebyshev distance from a cell.
+             */
+            template <typename Function>
+            void forEachShellCell(const Coord& origin, i64 ring, Function&& function) const {
+                if (ring == 0) {
+                    forEachCell(origin, origin, function);
+                    return;
+                }
+                const i64 fromX = std::max(origin.x - ring, low.x), toX = std::min(origin.x + ring, high.x);
+                const i64 fromY = std::max(origin.y - ring, low.y), toY = std::min(origin.y + ring, high.y);
+                for (i64 x = fromX; x <= toX; x++) {
+                    for (i64 y = fromY; y <= toY; y++) {
+                        if (std::abs(x - origin.x) == ring || std::abs(y - origin.y) == ring) {
+                            forEachCell({x, y, origin.z - ring}, {x, y, origin.z + ring}, function);
+                        } else {
+                            forEachCell({x, y, origin.z - ring}, {x, y, origin.z - ring}, function);
+                            forEachCell({x, y, origin.z + ring}, {x, y, origin.z + ring}, function);
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Records the position of an entity, moving it to another cell if it left its cell.
+             */
+            void move(u64 index, const P& position) {
+                if (index >= slots.size()) slots.resize(index + 1);
+                const Entry entry{index, static_cast<f32>(position.x), static_cast<f32>(position.y), static_cast<f32>(position.z)};
+                const Coord coord = cellOf(entry);
+                const u64 key = pack(coord);
+
+                Slot& slot = slots[index];
+                if (slot.cell != None && pack(cells[slot.cell].coord) == key) {
+                    cells[slot.cell].entries[slot.position] = entry;
+                    return;
+                }
+                if (slot.cell != None) erase(index);
+
+                auto [found, inserted] = lookup.try_emplace(key, static_cast<u32>(cells.size()));
+                if (inserted) {
+                    cells.push_back({coord, {}});
+                    if (cells.size() == 1) {
+                        low = high = coord;
+                    } else {
+                        low = {std::min(low.x, coord.x), std::min(low.y, coord.y), std::min(low.z, coord.z)};
+                        high = {std::max(high.x, coord.x), std::max(high.y, coord.y), std::max(high.z, coord.z)};
+                    }
+                }
+                std::vector<Entry>& entries = cells[found->second].entries;
+                slot = {found->second, static_cast<u32>(entries.size())};
+                entries.push_back(entry);
+                count++;
+            }
+
+            /**
+             * @brief Stops tracking an entity, if tracked.
+             */
+            void erase(u64 index) {
+                if (index >= slots.size() || slots[index].cell == None) return;
+                Slot& slot = slots[index];
+                std::vector<Entry>& entries = cells[slot.cell].entries;
+                entries[slot.position] = entries.back();
+                slots[entries[slot.position].index].position = slot.position;
+                entries.pop_back();
+                slot.cell = None;
+                count--;
+            }
+
+            /**
+             * @brief Forgets every entity and cell.
+             */
+            void clear() {
+                cells.clear();
+                lookup.clear();
+                slots.clear();
+                low = {0, 0, 0};
+                high = {-1, -1, -1};
+                count = 0;
+            }
+        };
+    }  // namespace Spatial
+}  // namespace iodine::core
@@ -0,0 +1,119 @@
+#include "ecs/system/scheduler.hpp"
+
+#include "debug/exception.hpp"
+#include "ecs/world.hpp"
+
+namespace iodine::core {
+    void Scheduler::add(System&& system) {
+        for (const System& existing : systems) {
+            if (existing.getName() == system.getName()) {
+                THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "A system with this name already exists");
+            }
+        }
+        system.phase = phase;
+        systems.push_back(std::move(system));
+        dirty = true;
+    }
+
+    void Scheduler::addSyncPoint() {
+        phase++;
+        dirty = true;
+    }
+
+    void Scheduler::run(World& world, f64 dt, ThreadPool* pool) {
+        u32 currentPhase = 0;
+        for (const std::vector<u64>& stage : getStages()) {
+            if (systems[stage.front()].phase != currentPhase) {
+                world.sync();
+                currentPhase = systems[stage.front()].phase;
+            }
+            if (!pool || stage.size() == 1) {
+                for (u64 index : stage) systems[index].run(world, dt);
+                continue;
+            }
+            pool->parallelFor(stage.size(), 1, [&](u64 begin, u64 end) {
+                for (u64 i = begin; i < end; i++) systems[stage[i]].run(world, dt);
+            });
+        }
+        world.sync();
+    }
+
+    const std::vector<std::vector<u64>>& Scheduler::getStages() {
+        if (dirty) {
+            build();
+            dirty = false;
+        }
+        return stages;
+    }
+
+    void Scheduler::build() {
+        const u64 count = systems.size();
+        std::unordered_map<std::string_view, u64> indices;
+        for (u64 i = 0; i < count; i++) {
+            indices.emplace(systems[i].getName(), i);
+        }
+        auto find = [&](const std::string& name) {
+            auto it = indices.find(name);
+            if (it == indices.end()) {
+                THROW_CORE_EXCEPTION(Exception::Type::NotFound, "System ordering refers to an unknown system");
+            }
+            return it->second;
+        };
+
+        // Explicit constraints and sync points.
+        std::vector<std::vector<u64>> predecessors(count);
+        for (u64 i = 0; i < count; i++) {
+            for (const std::string& name : systems[i].getAfter()) predecessors[i].push_back(find(name));
+            for (const std::string& name : systems[i].getBefore()) predecessors[find(name)].push_back(i);
+            for (u64 j = 0; j < count; j++) {
+                if (systems[j].phase < systems[i].phase) predecessors[i].push_back(j);
+            }
+        }
+
+        // Topological order, preferring insertion order among ready systems.
+        std::vector<u64> pending(count, 0);
+        std::vector<std::vector<u64>> successors(count);
+        for (u64 i = 0; i < count; i++) {
+            for (u64 p : predecessors[i]) {
+                successors[p].push_back(i);
+                pending[i]++;
+            }
+        }
+        std::vector<u64> order;
+        std::vector<b8> placed(count, false);
+        while (order.size() < count) {
+            u64 next = count;
+            for (u64 i = 0; i < count; i++) {
+                if (!placed[i] && pending[i] == 0) {
+                    next = i;
+                    break;
+                }
+            }
+            if (next == count) {
+                THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "System ordering constraints contain a cycle");
+            }
+            placed[next] = true;
+            order.push_back(next);
+            for (u64 s : successors[next]) pending[s]--;
+        }
+
+        // Each system goes one stage past its predecessors and past every earlier system it conflicts with.
+        std::vector<u64> stageOf(count, 0);
+        u64 stageCount = 0;
+        for (u64 k = 0; k < count; k++) {
+            const u64 i = order[k];
+            u64 stage = 0;
+            for (u64 p : predecessors[i]) stage = std::max(stage, stageOf[p] + 1);
+            for (u64 e = 0; e < k; e++) {
+                if (systems[i].conflicts(systems[order[e]])) stage = std::max(stage, stageOf[order[e]] + 1);
+            }
+            stageOf[i] = stage;
+            stageCount = std::max(stageCount, stage + 1);
+        }
+
+        stages.assign(stageCount, {});
+        for (u64 i : order) {
+            stages[stageOf[i]].push_back(i);
+        }
+    }
+}  // namespace iodine::core
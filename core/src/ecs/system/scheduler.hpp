@@ -0,0 +1,54 @@
+#pragma once
+
+#include "concurrency/thread_pool.hpp"
+#include "ecs/system/system.hpp"
+
+namespace iodine::core {
+    /**
+     * @brief Orders systems into stages. Systems within a stage do not conflict and run concurrently; stages run one after
+     *        another. Conflicting systems keep the order they were added in unless an explicit constraint says otherwise.
+     */
+    class IO_API Scheduler {
+        public:
+        Scheduler() = default;
+        ~Scheduler() = default;
+
+        /**
+         * @brief Adds a system.
+         * @param system The system to add. Its name must be unique.
+         */
+        void add(System&& system);
+
+        /**
+         * @brief Inserts a sync point: every system added before it finishes before any system added after it starts.
+         */
+        void addSyncPoint();
+
+        /**
+         * @brief Runs every system once. Deferred commands are played back at every sync point and after the last stage.
+         * @param world The world to run on.
+         * @param dt The time since the last tick.
+         * @param pool The pool to run concurrent systems on. Systems run sequentially if null.
+         */
+        void run(World& world, f64 dt, ThreadPool* pool = nullptr);
+
+        /**
+         * @brief Gets the stages, rebuilding them if systems were added since the last call.
+         * @return The indices of the systems in each stage.
+         */
+        const std::vector<std::vector<u64>>& getStages();
+
+        inline const std::vector<System>& getSystems() const noexcept { return systems; }
+
+        private:
+        std::vector<System> systems;             ///< Every system, in insertion order.
+        std::vector<std::vector<u64>> stages;    ///< Indices of the systems of each stage.
+        u32 phase = 0;                           ///< The current sync point phase.
+        b8 dirty = false;                        ///< Whether the stages must be rebuilt.
+
+        /**
+         * @brief Builds the stages from the declared access sets and ordering constraints.
+         */
+        void build();
+    };
+}  // namespace iodine::core
@@ -0,0 +1,21 @@
+#include "ecs/system/system.hpp"
+
+#include "ecs/world.hpp"
+
+namespace iodine::core {
+    void System::run(World& world, f64 dt) {
+        const Component::Tick tick = world.getClock().advance();
+        {
+            Component::Clock::Scope scope(tick, lastRun);
+            function(world, dt);
+        }
+        lastRun = tick;
+    }
+
+    b8 System::conflicts(const System& other) const noexcept {
+        if (exclusive || other.exclusive) return true;
+        return writes.intersects(other.writes) || writes.intersects(other.reads) || reads.intersects(other.writes) ||
+               resourceWrites.intersects(other.resourceWrites) || resourceWrites.intersects(other.resourceReads) ||
+               resourceReads.intersects(other.resourceWrites);
+    }
+}  // namespace iodine::core
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <functional>
+
+#include "ecs/component/registry.hpp"
+#include "ecs/resource/types.hpp"
+
+namespace iodine::core {
+    class World;
+
+    /**
+     * @brief A unit of per-tick logic with declared component access. The scheduler uses the access sets to run systems
+     *        that do not conflict in parallel.
+     */
+    class IO_API System {
+        public:
+        using Function = std::function<void(World&, f64)>;
+        class Builder;
+
+        /**
+         * @brief Runs the system with a fresh change-detection tick. Views created inside the system filter on changes
+         *        made since its previous run.
+         * @param world The world to run on.
+         * @param dt The time since the last tick.
+         */
+        void run(World& world, f64 dt);
+
+        /**
+         * @brief Checks whether two systems may not run at the same time.
+         * @param other The other system.
+         * @return True if either system writes a component or resource the other one accesses, or either system is exclusive.
+         */
+        b8 conflicts(const System& other) const noexcept;
+
+        inline const std::string& getName() const noexcept { return name; }
+        inline const Component::Signature& getReads() const noexcept { return reads; }
+        inline const Component::Signature& getWrites() const noexcept { return writes; }
+        inline const Resource::Signature& getResourceReads() const noexcept { return resourceReads; }
+        inline const Resource::Signature& getResourceWrites() const noexcept { return resourceWrites; }
+        inline const std::vector<std::string>& getAfter() const noexcept { return after; }
+        inline const std::vector<std::string>& getBefore() const noexcept { return before; }
+        inline b8 isExclusive() const noexcept { return exclusive; }
+        inline Component::Tick getLastRun() const noexcept { return lastRun; }
+
+        private:
+        friend class Scheduler;
+
+        std::string name;                    ///< The unique name of the system.
+        Function function;                   ///< The system body.
+        Component::Signature reads;          ///< Components the system only reads.
+        Component::Signature writes;         ///< Components the system writes.
+        Resource::Signature resourceReads;   ///< Resources the system only reads.
+        Resource::Signature resourceWrites;  ///< Resources the system writes.
+        std::vector<std::string> after;      ///< Systems that must finish before this one starts.
+        std::vector<std::string> before;     ///< Systems that must not start before this one finishes.
+        b8 exclusive = false;                ///< Whether the system must run alone.
+        u32 phase = 0;                       ///< The sync-point-delimited phase the system was added in.
+        Component::Tick lastRun = 0;         ///< The tick of the previous run, zero if it never ran.
+    };
+
+    /**
+     * @brief Declares a system's access and ordering constraints.
+     */
+    class IO_API System::Builder {
+        public:
+        /**
+         * @brief Starts declaring a system.
+         * @param name The unique name of the system.
+         * @param components The registry used to resolve component IDs.
+         */
+        Builder(const std::string& name, Component::Registry& components) : components(components) { system.name = name; }
+
+        /**
+         * @brief Declares read-only access to components.
+         * @tparam Ts The component types.
+         */
+        template <Component::Component... Ts>
+        Builder& reads() {
+            (system.reads.set(components.enter<Ts>()), ...);
+            return *this;
+        }
+
+        /**
+         * @brief Declares read-write access to components.
+         * @tparam Ts The component types.
+         */
+        template <Component::Component... Ts>
+        Builder& writes() {
+            (system.writes.set(components.enter<Ts>()), ...);
+            return *this;
+        }
+
+        /**
+         * @brief Declares read-only access to resources.
+         * @tparam Ts The resource types.
+         */
+        template <typename... Ts>
+        Builder& readsResource() {
+            (system.resourceReads.set(Resource::Types::of<Ts>()), ...);
+            return *this;
+        }
+
+        /**
+         * @brief Declares read-write access to resources.
+         * @tparam Ts The resource types.
+         */
+        template <typename... Ts>
+        Builder& writesResource() {
+            (system.resourceWrites.set(Resource::Types::of<Ts>()), ...);
+            return *this;
+        }
+
+        /**
+         * @brief Orders this system after another one.
+         * @param other The name of the system that must run first.
+         */
+        Builder& after(const std::string& other) {
+            system.after.push_back(other);
+            return *this;
+        }
+
+        /**
+         * @brief Orders this system before another one.
+         * @param other The name of the system that must run later.
+         */
+        Builder& before(const std::string& other) {
+            system.before.push_back(other);
+            return *this;
+        }
+
+        /**
+         * @brief Makes the system run alone, e.g. because it makes structural changes to the world.
+         */
+        Builder& exclusive() {
+            system.exclusive = true;
+            return *this;
+        }
+
+        /**
+         * @brief Finishes the declaration.
+         * @param function The system body.
+         * @return The system.
+         */
+        System build(Function function) {
+            system.function = std::move(function);
+            return std::move(system);
+        }
+
+        private:
+        Component::Registry& components;  ///< Resolves component IDs.
+        System system;                    ///< The system being declared.
+    };
+}  // namespace iodine::core
@@ -0,0 +1,472 @@
+#pragma once
+
+#include <numeric>
+#include <tuple>
+
+#include "chrono/timer.hpp"
+#include "concurrency/thread_pool.hpp"
+#include "debug/metrics.hpp"
+#include "ecs/component/registry.hpp"
+#include "ecs/entity/registry.hpp"
+#include "ecs/filter.hpp"
+
+namespace iodine::core {
+    template <typename Components, typename Filters>
+    class BasicView;
+
+    /**
+     * @brief Iterates every entity that has all of the given components.
+     *        In sparse mode the smallest pool drives the iteration and each candidate is admitted by one test of its
+     *        component mask against precomputed include / exclude masks; in archetype mode every matching table is
+     *        walked column by column.
+     *        Non-const components are marked changed as they are visited.
+     * @tparam Ts The component types. Const-qualify a type to get read-only access to it. Optional<T> terms pass a
+     *            pointer that is nullptr for entities without T.
+     * @tparam Fs Filter terms (With<T>, Without<T>, Added<T>, Changed<T>). Change filters are only supported in sparse mode.
+     * @warning Adding or removing components of the viewed types while iterating invalidates the view.
+     */
+    template <typename... Ts, typename... Fs>
+    class BasicView<std::tuple<Ts...>, std::tuple<Fs...>> {
+        STATIC_ASSERT((!Filter::IsOptional<Ts> || ...) || (!Filter::IsExclusion<Fs> || ...), "A view needs at least one required component type or tag");
+
+        template <typename T>
+        using Base = std::remove_const_t<typename Filter::Target<T>::Type>;
+        template <std::size_t I>
+        using Term = std::tuple_element_t<I, std::tuple<Ts...>>;
+        using Indices = std::index_sequence_for<Ts...>;
+
+        public:
+        static constexpr u64 DefaultChunkSize = 1024;  ///< Default number of elements per parallel chunk.
+
+        /**
+         * @brief Creates a view over the given registries.
+         * @param entities The entity registry used to resolve entity versions.
+         * @param components The component registry holding the data.
+         */
+        BasicView(Entity::Registry& entities, Component::Registry& components)
+            : entities(&entities), mode(components.getMode()), since(Component::Clock::since()), clock(&components.getClock()) {
+            if (mode == Component::Mode::Archetype) {
+                if constexpr ((Filter::IsChange<Fs> || ...)) {
+                    THROW_CORE_EXCEPTION(Exception::Type::NotSupported, "Change filters require sparse component storage");
+                }
+                ids = {Component::Types::of<Base<Ts>>()...};
+                archetypes = &components.getArchetypes();
+                collectTables();
+            } else {
+                pools = {components.template getPool<Base<Ts>>()...};
+                filters = {components.template getPool<typename Fs::Type>()...};
+                masks = &components.getMasks();
+                selectDriver(Indices{}, std::index_sequence_for<Fs...>{});
+            }
+        }
+
+        /**
+         * @brief Calls a function for every matching entity.
+         * @tparam Function Invocable with (Entity, Ts&...) or (Ts&...), taking T* for Optional<T> terms.
+         * @param function The function to call.
+         */
+        template <typename Function>
+        void each(Function&& function) {
+            if (mode == Component::Mode::Sparse) {
+                prepareWrites(Indices{});
+                eachSparse(function, 0, driverSize, Indices{});
+                return;
+            }
+            for (Archetype::Table* table : tables) {
+                eachTable(function, *table, 0, table->getSize(), Indices{});
+            }
+        }
+
+        /**
+         * @brief Calls a function for every matching entity, spreading chunks of the iteration across a thread pool.
+         *        Chunk boundaries are rounded so that every chunk starts on a cache line of the iterated arrays, or, when
+         *        the driving pool is chunked, so that every chunk covers whole storage chunks.
+         * @tparam Function Invocable with (Entity, Ts&...) or (Ts&...), taking T* for Optional<T> terms. Called
+         *                  concurrently from several threads.
+         * @param pool The thread pool to run on. The calling thread takes part in the work.
+         * @param chunkSize The number of elements per chunk.
+         * @param label If not null, the duration of every chunk is registered with Metrics under this label.
+         * @warning The function must not add or remove components or entities.
+         */
+        template <typename Function>
+        void forEachParallel(ThreadPool& pool, Function&& function, u64 chunkSize = DefaultChunkSize, const char* label = nullptr) {
+            auto timed = [&](auto&& body) {
+                if (!label) {
+                    body();
+                    return;
+                }
+                Timer timer;
+                timer.start();
+                body();
+                Metrics::getInstance().registerTiming(label, timer.tick());
+            };
+
+            if (mode == Component::Mode::Sparse) {
+                prepareWrites(Indices{});
+                const u64 chunk = driverChunk ? (chunkSize + driverChunk - 1) / driverChunk * driverChunk : alignChunk(chunkSize, driverStride);
+                pool.parallelFor(driverSize, chunk, [&](u64 begin, u64 end) { timed([&] { eachSparse(function, begin, end, Indices{}); }); });
+                return;
+            }
+
+            struct Span {
+                Archetype::Table* table;
+                u64 begin;
+                u64 end;
+            };
+            const u64 chunk = alignChunk(chunkSize, TableStride);
+            std::vector<Span> spans;
+            for (Archetype::Table* table : tables) {
+                for (u64 begin = 0; begin < table->getSize(); begin += chunk) {
+                    spans.push_back({table, begin, std::min(table->getSize(), begin + chunk)});
+                }
+            }
+            pool.parallelFor(spans.size(), 1, [&](u64 first, u64 last) {
+                for (u64 i = first; i < last; i++) {
+                    timed([&] { eachTable(function, *spans[i].table, spans[i].begin, spans[i].end, Indices{}); });
+                }
+            });
+        }
+
+        /**
+         * @brief Brings a view kept across calls up to date: takes the running system's change reference, re-selects
+         *        the smallest pool, and matches only the tables created since the previous refresh. Much cheaper than
+         *        building a new view, which resolves every pool and matches every table again.
+         */
+        void refresh() {
+            since = Component::Clock::since();
+            if (mode == Component::Mode::Sparse) {
+                selectDriver(Indices{}, std::index_sequence_for<Fs...>{});
+            } else {
+                collectTables();
+            }
+        }
+
+        /**
+         * @brief An upper bound on the number of matching entities.
+         * @return The size of the driving pool, or the number of rows in matching tables.
+         */
+        u64 sizeHint() const noexcept {
+            if (mode == Component::Mode::Sparse) return driverSize;
+            u64 count = 0;
+            for (const Archetype::Table* table : tables) count += table->getSize();
+            return count;
+        }
+
+        /**
+         * @brief Forward iterator yielding (Entity, Ts&...) tuples, with T* for Optional<T> terms.
+         */
+        class Iterator {
+            public:
+            using value_type = std::tuple<Entity, Filter::Ref<Ts>...>;
+            using difference_type = std::ptrdiff_t;
+
+            Iterator(BasicView* view, u64 table, u64 position) : view(view), table(table), position(position) { settle(); }
+
+            value_type operator*() const { return view->fetch(table, position, Indices{}); }
+
+            Iterator& operator++() {
+                position++;
+                settle();
+                return *this;
+            }
+
+            Iterator operator++(int) {
+                Iterator copy = *this;
+                ++*this;
+                return copy;
+            }
+
+            inline b8 operator==(const Iterator& other) const noexcept { return table == other.table && position == other.position; }
+            inline b8 operator!=(const Iterator& other) const noexcept { return !(*this == other); }
+
+            private:
+            BasicView* view;  ///< The view being iterated.
+            u64 table;        ///< The current table (archetype mode), always 0 in sparse mode.
+            u64 position;     ///< The current row / dense position.
+
+            /**
+             * @brief Advances to the next matching element, or to the end.
+             */
+            void settle() {
+                if (view->mode == Component::Mode::Sparse) {
+                    while (position < view->driverSize && !view->matches(position, Indices{})) position++;
+                    return;
+                }
+                while (table < view->tables.size() && position >= view->tables[table]->getSize()) {
+                    table++;
+                    position = 0;
+                }
+                if (table == view->tables.size()) position = 0;
+            }
+        };
+
+        Iterator begin() {
+            if (mode == Component::Mode::Sparse) prepareWrites(Indices{});
+            return Iterator(this, 0, 0);
+        }
+        Iterator end() { return mode == Component::Mode::Sparse ? Iterator(this, 0, driverSize) : Iterator(this, tables.size(), 0); }
+
+        private:
+        Entity::Registry* entities;                                          ///< Resolves entity indices to entities.
+        Component::Mode mode;                                                ///< The storage layout being viewed.
+        Component::Tick since;                                               ///< Filters match changes stamped after this tick.
+        const Component::Clock* clock;                                       ///< The registry's clock.
+        Component::Tick tick = 0;                                            ///< Writes of the current iteration are stamped with this tick.
+        std::tuple<Component::Pool<Base<Ts>>*...> pools;                     ///< The pools of every component (sparse mode).
+        std::tuple<Component::Pool<typename Fs::Type>*...> filters;          ///< The pools filtered on (sparse mode).
+        const std::vector<Component::Signature>* masks = nullptr;            ///< Component masks by entity index (sparse mode).
+        u64 driver = 0;                                                      ///< The position of the smallest pool in Ts, sizeof...(Ts) for a filter.
+        const u64* driverIndices = nullptr;                                  ///< Entity indices of the smallest pool.
+        u64 driverSize = 0;                                                  ///< The size of the smallest pool.
+        u64 driverStride = 1;                                                ///< The component size of the smallest pool.
+        u64 driverChunk = 0;                                                 ///< The storage chunk capacity of the smallest pool, 0 if contiguous.
+        static constexpr u64 TableStride = std::max({u64(1), u64(sizeof(Base<Ts>))...});  ///< The widest component, used to align table chunks.
+        std::array<Component::ID, sizeof...(Ts)> ids{};                      ///< The component IDs (archetype mode).
+        std::vector<Archetype::Table*> tables;                               ///< The matching tables, possibly empty (archetype mode).
+        Archetype::Registry* archetypes = nullptr;                           ///< The tables matched against (archetype mode).
+        u64 scanned = 0;                                                     ///< The number of tables matched so far (archetype mode).
+
+        /**
+         * @brief The components a matching entity must have: the required component terms and the With, Added and
+         *        Changed filter terms.
+         */
+        static const Component::Signature& includeMask() {
+            static const Component::Signature signature = [] {
+                Component::Signature bits;
+                ((Filter::IsOptional<Ts> ? void() : bits.set(Component::Types::of<Base<Ts>>())), ...);
+                ((Filter::IsExclusion<Fs> ? void() : bits.set(Component::Types::of<typename Fs::Type>())), ...);
+                return bits;
+            }();
+            return signature;
+        }
+
+        /**
+         * @brief The components a matching entity must not have: the Without filter terms.
+         */
+        static const Component::Signature& excludeMask() {
+            static const Component::Signature signature = [] {
+                Component::Signature bits;
+                ((Filter::IsExclusion<Fs> ? bits.set(Component::Types::of<typename Fs::Type>()) : void()), ...);
+                return bits;
+            }();
+            return signature;
+        }
+
+        /**
+         * @brief Matches the tables created since the last call. Tables are never destroyed, so earlier matches stay
+         *        valid; empty ones are kept because they may fill up later.
+         */
+        void collectTables() {
+            const std::vector<Unique<Archetype::Table>>& all = archetypes->getTables();
+            for (; scanned < all.size(); scanned++) {
+                if (all[scanned]->getSignature().matches(includeMask(), excludeMask())) tables.push_back(all[scanned].get());
+            }
+        }
+
+        /**
+         * @brief Picks the smallest pool an entity must be in to drive the iteration: a required component, a tag or
+         *        a With / Added / Changed filter. Filter pools are only walked for their indices; components are looked up.
+         */
+        template <std::size_t... I, std::size_t... J>
+        void selectDriver(std::index_sequence<I...>, std::index_sequence<J...>) {
+            driverSize = std::numeric_limits<u64>::max();
+            (
+                [&] {
+                    if constexpr (!Filter::IsOptional<Term<I>>) {
+                        const auto* pool = std::get<I>(pools);
+                        if (pool->getSize() < driverSize) {
+                            driver = I;
+                            driverSize = pool->getSize();
+                            driverIndices = pool->getIndices();
+                            driverStride = sizeof(Base<Term<I>>);
+                            driverChunk = Component::Pool<Base<Term<I>>>::ChunkCapacity;
+                        }
+                    }
+                }(),
+                ...);
+            (
+                [&] {
+                    if constexpr (!Filter::IsExclusion<std::tuple_element_t<J, std::tuple<Fs...>>>) {
+                        const auto* pool = std::get<J>(filters);
+                        if (pool->getSize() < driverSize) {
+                            driver = sizeof...(Ts);
+                            driverSize = pool->getSize();
+                            driverIndices = pool->getIndices();
+                            driverStride = 1;
+                            driverChunk = 0;
+                        }
+                    }
+                }(),
+                ...);
+        }
+
+        /**
+         * @brief Fetches the component of pool I for the entity at a driver position, or nullptr if it has none.
+         */
+        template <std::size_t I>
+        inline auto* probe(u64 index, u64 position) const noexcept {
+            auto* pool = std::get<I>(pools);
+            return driver == I ? &pool->getAt(position) : pool->find(index);
+        }
+
+        template <std::size_t... I>
+        inline b8 matches(u64 position, std::index_sequence<I...>) const noexcept {
+            const u64 index = driverIndices[position];
+            return admits(index) && filtered(index, std::index_sequence_for<Fs...>{});
+        }
+
+        /**
+         * @brief Checks an entity's component mask against the include and exclude masks in one pass.
+         */
+        inline b8 admits(u64 index) const noexcept { return index < masks->size() && (*masks)[index].matches(includeMask(), excludeMask()); }
+
+        /**
+         * @brief Checks an entity index against every change filter term. Presence terms are covered by admits().
+         */
+        template <std::size_t... I>
+        inline b8 filtered([[maybe_unused]] u64 index, std::index_sequence<I...>) const noexcept {
+            return ([&]() -> b8 {
+                using F = std::tuple_element_t<I, std::tuple<Fs...>>;
+                if constexpr (Filter::IsChange<F>) {
+                    const Component::Stamp* stamp = std::get<I>(filters)->getStamp(index);
+                    return stamp && Filter::passes<F>(*stamp, since);
+                } else {
+                    return true;
+                }
+            }() && ...);
+        }
+
+        /**
+         * @brief Takes the tick writes are stamped with and bumps the revision of every pool the view writes to, once
+         *        per iteration, on the calling thread. Parallel workers run outside the system's clock scope, so they
+         *        must not read the tick themselves.
+         */
+        template <std::size_t... I>
+        inline void prepareWrites(std::index_sequence<I...>) noexcept {
+            tick = clock->now();
+            (
+                [&] {
+                    if constexpr (!std::is_const_v<typename Filter::Target<Term<I>>::Type>) std::get<I>(pools)->touch();
+                }(),
+                ...);
+        }
+
+        /**
+         * @brief Marks every present non-const component of the entity at a driver position as changed.
+         */
+        template <std::size_t... I>
+        inline void markChanged(u64 index, u64 position, const std::tuple<Base<Ts>*...>& components, std::index_sequence<I...>) noexcept {
+            (
+                [&] {
+                    if constexpr (!std::is_const_v<typename Filter::Target<Term<I>>::Type>) {
+                        if (!std::get<I>(components)) return;
+                        auto* pool = std::get<I>(pools);
+                        pool->markChangedAt(driver == I ? position : pool->getPosition(index), tick);
+                    }
+                }(),
+                ...);
+        }
+
+        /**
+         * @brief Turns a component pointer into what the view passes for term I: a reference, or the pointer itself
+         *        for Optional<T>.
+         */
+        template <std::size_t I>
+        static inline Filter::Ref<Term<I>> pass(Base<Term<I>>* component) noexcept {
+            if constexpr (Filter::IsOptional<Term<I>>) {
+                return component;
+            } else {
+                return *component;
+            }
+        }
+
+        /**
+         * @brief Gets the column of term I in a table, or nullptr if an Optional<T> term's column is missing.
+         */
+        template <std::size_t I>
+        inline Base<Term<I>>* column(Archetype::Table& table) const noexcept {
+            if constexpr (Filter::IsOptional<Term<I>>) {
+                if (!table.has(ids[I])) return nullptr;
+            }
+            return table.template getData<Base<Term<I>>>(ids[I]);
+        }
+
+        /**
+         * @brief Gets what the view passes for term I from a table column, which is nullptr for a missing optional.
+         */
+        template <std::size_t I>
+        static inline Filter::Ref<Term<I>> at(Base<Term<I>>* column, u64 row) noexcept {
+            if constexpr (Filter::IsOptional<Term<I>>) {
+                return column ? column + row : nullptr;
+            } else {
+                return column[row];
+            }
+        }
+
+        template <std::size_t... I>
+        std::tuple<Entity, Filter::Ref<Ts>...> fetch(u64 table, u64 position, std::index_sequence<I...>) {
+            if (mode == Component::Mode::Sparse) {
+                const u64 index = driverIndices[position];
+                const std::tuple<Base<Ts>*...> components{probe<I>(index, position)...};
+                markChanged(index, position, components, Indices{});
+                return {entities->at(index), pass<I>(std::get<I>(components))...};
+            }
+            Archetype::Table& current = *tables[table];
+            return {current.getEntities()[position], at<I>(column<I>(current), position)...};
+        }
+
+        template <typename Function, std::size_t... I>
+        void eachSparse(Function& function, u64 begin, u64 end, std::index_sequence<I...>) {
+            for (u64 position = begin; position < end; position++) {
+                const u64 index = driverIndices[position];
+                if (!admits(index)) continue;
+                if constexpr ((Filter::IsChange<Fs> || ...)) {
+                    if (!filtered(index, std::index_sequence_for<Fs...>{})) continue;
+                }
+                const std::tuple<Base<Ts>*...> components{probe<I>(index, position)...};
+                markChanged(index, position, components, Indices{});
+                invoke(function, index, pass<I>(std::get<I>(components))...);
+            }
+        }
+
+        template <typename Function, std::size_t... I>
+        void eachTable(Function& function, Archetype::Table& table, u64 begin, u64 end, std::index_sequence<I...>) {
+            const Entity* owners = table.getEntities().data();
+            const std::tuple<Base<Ts>*...> columns{column<I>(table)...};
+            for (u64 row = begin; row < end; row++) {
+                if constexpr (std::is_invocable_v<Function&, Entity, Filter::Ref<Ts>...>) {
+                    function(owners[row], at<I>(std::get<I>(columns), row)...);
+                } else {
+                    function(at<I>(std::get<I>(columns), row)...);
+                }
+            }
+        }
+
+        /**
+         * @brief Rounds a chunk size up so that chunks of elements of the given size start on 64-byte boundaries.
+         * @param chunkSize The requested number of elements per chunk.
+         * @param stride The element size in bytes.
+         * @return The adjusted number of elements per chunk.
+         */
+        static u64 alignChunk(u64 chunkSize, u64 stride) {
+            const u64 granule = 64 / std::gcd(stride, u64(64));
+            return std::max<u64>(granule, (chunkSize + granule - 1) / granule * granule);
+        }
+
+        template <typename Function>
+        inline void invoke(Function& function, u64 index, Filter::Ref<Ts>... components) {
+            if constexpr (std::is_invocable_v<Function&, Entity, Filter::Ref<Ts>...>) {
+                function(entities->at(index), components...);
+            } else {
+                function(components...);
+            }
+        }
+    };
+
+    /**
+     * @brief A view over the given terms: component types (const-qualified for read-only access) and filter terms.
+     *        Filter terms and tags may appear anywhere; only the non-empty component types are passed to the view's function.
+     */
+    template <typename... Terms>
+    using View = BasicView<typename Filter::Split<std::tuple<>, std::tuple<>, Terms...>::Components, typename Filter::Split<std::tuple<>, std::tuple<>, Terms...>::Filters>;
+}  // namespace iodine::core
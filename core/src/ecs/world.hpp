@@ -1,6 +1,15 @@
 #pragma once
 
-#include "ecs/component/registry.hpp"
+#include "ecs/command/commands.hpp"
+#include "ecs/event/events.hpp"
+#include "ecs/hierarchy/hierarchy.hpp"
+#include "ecs/query.hpp"
+#include "ecs/render/frame.hpp"
+#include "ecs/resource/registry.hpp"
+#include "ecs/snapshot/snapshot.hpp"
+#include "ecs/spatial/grid.hpp"
+#include "ecs/system/scheduler.hpp"
+#include "ecs/view.hpp"
 
 namespace iodine::core {
     /**
@@ -8,42 +17,92 @@ namespace iodine::core {
      */
     class World {
         public:
-        World() = default;
+        /**
+         * @brief Creates a new world.
+         * @param mode The storage layout for the world's components (sparse pools or archetype tables).
+         */
+        explicit World(Component::Mode mode = Component::Mode::Sparse) : components(mode), commands(entities, components), hierarchy(entities, components) {}
         ~World() = default;
 
+        /**
+         * @brief Creates a new entity.
+         * @return The new entity.
+         */
+        Entity createEntity() { return entities.create(); }
+
+        /**
+         * @brief Destroys an entity along with its components. Stale handles are ignored.
+         * @param entity The entity to destroy.
+         */
+        void destroyEntity(const Entity& entity) {
+            if (!entities.isAlive(entity)) return;
+            components.destroy(entity);
+            entities.destroy(entity);
+        }
+
+        /**
+         * @brief Creates several entities at once.
+         * @tparam OutputIt An output iterator accepting Entity.
+         * @param count The number of entities to create.
+         * @param out Receives the new entities.
+         * @return The output iterator past the last written entity.
+         */
+        template <typename OutputIt>
+        OutputIt createEntities(u64 count, OutputIt out) {
+            return entities.createBatch(count, out);
+        }
+
+        /**
+         * @brief Destroys several entities along with their components. Stale handles are ignored.
+         * @param batch The entities to destroy.
+         */
+        void destroyEntities(std::span<const Entity> batch) {
+            for (const Entity& entity : batch) {
+                if (entities.isAlive(entity)) components.destroy(entity);
+            }
+            entities.destroyBatch(batch);
+        }
+
+        /**
+         * @brief Checks if an entity is alive.
+         * @param entity The entity to check.
+         * @return True if the entity is alive, false otherwise.
+         */
+        b8 isAlive(const Entity& entity) const { return entities.isAlive(entity); }
+
         /**
          * @brief Registers a new component type with the world.
          * @tparam T The component type to register.
          * @return The ID for the registered component type.
          * @note This should be used by plugins on load.
          */
-        template <typename T>
+        template <Component::Component T>
         Component::ID registerComponent() {
-            return components.registerComponent<T>();
+            return components.enter<T>();
         }
 
         /**
          * @brief Adds a component to the given entity.
          * @tparam T The component type to add.
+         * @tparam Args The types of the arguments to forward to the component constructor.
          * @param entity The entity to add the component to.
+         * @param ...args The arguments to forward to the component constructor.
          * @return The created component.
          */
-        template <typename T>
-        T& addComponent(const Entity& entity) {
-            return components.createComponent<T>(entity);
+        template <Component::Component T, typename... Args>
+        T& addComponent(const Entity& entity, Args&&... args) {
+            return components.create<T>(entity, std::forward<Args>(args)...);
         }
 
         /**
-         * @brief Adds a component to the given entity.
+         * @brief Adds a copy of a component to every given entity.
          * @tparam T The component type to add.
-         * @tparam Args The types of the arguments to forward to the component constructor.
-         * @param entity The entity to add the component to.
-         * @param ...args The arguments to forward to the component constructor.
-         * @return The created component.
+         * @param batch The entities to add the component to.
+         * @param component The component to copy.
          */
-        template <typename T, typename... Args>
-        T& addComponent(const Entity& entity, Args&&... args) {
-            return components.createComponent<T>(entity, std::forward<Args>(args)...);
+        template <Component::Component T>
+        void addComponents(std::span<const Entity> batch, const T& component) {
+            components.createBatch<T>(batch, component);
         }
 
         /**
@@ -51,9 +110,20 @@ namespace iodine::core {
          * @tparam T The component type to remove.
          * @param entity The entity to remove the component from.
          */
-        template <typename T>
+        template <Component::Component T>
         void removeComponent(const Entity& entity) {
-            components.removeComponent<T>(entity);
+            components.remove<T>(entity);
+        }
+
+        /**
+         * @brief Checks whether the given entity has all of the given components.
+         * @tparam Ts The component types to check for.
+         * @param entity The entity to check.
+         * @return True if the entity has every component, false otherwise.
+         */
+        template <Component::Component... Ts>
+        b8 hasComponent(const Entity& entity) {
+            return components.has<Ts...>(entity);
         }
 
         /**
@@ -62,9 +132,9 @@ namespace iodine::core {
          * @param entity The entity to get the component for.
          * @return The component for the given entity.
          */
-        template <typename T>
+        template <Component::Component T>
         T& getComponent(const Entity& entity) {
-            return components.getComponent<T>(entity);
+            return components.get<T>(entity);
         }
 
         /**
@@ -73,12 +143,377 @@ namespace iodine::core {
          * @param entity The entity to get the component for.
          * @return The component for the given entity.
          */
-        template <typename T>
+        template <Component::Component T>
         const T& getComponent(const Entity& entity) const {
-            return components.getComponent<T>(entity);
+            return components.get<T>(entity);
+        }
+
+        /**
+         * @brief Creates a view over every entity that has all of the given components.
+         * @tparam Ts The component types. Const-qualify a type for read-only access. Added<T> and Changed<T> terms
+         *            restrict the view to components added / changed since the running system last ran, Without<T>
+         *            skips entities holding T, and Optional<T> passes a T* that is nullptr for entities without T.
+         * @return The view. Use each() or a range-for loop to iterate it.
+         */
+        template <typename... Ts>
+        View<Ts...> view() {
+            return View<Ts...>(entities, components);
+        }
+
+        /**
+         * @brief Creates a persistent query, a view that caches its pools and matching tables across calls. Capture it
+         *        in a system instead of creating a view on every run.
+         * @tparam Ts The view terms, see view().
+         * @return The query.
+         */
+        template <typename... Ts>
+        Query<Ts...> query() {
+            return Query<Ts...>(entities, components);
+        }
+
+        /**
+         * @brief Sorts the components of a type in place, so that views driven by them iterate in that order.
+         * @tparam T The component type.
+         * @tparam Compare A strict weak ordering invocable with (const T&, const T&).
+         * @param compare The ordering.
+         * @param incremental Use an insertion sort, cheap when the components are already mostly sorted.
+         * @warning Sparse mode only.
+         */
+        template <Component::Component T, typename Compare>
+        void sort(Compare compare, b8 incremental = false) {
+            Component::Pool<T>* pool = components.getPool<T>();
+            incremental ? pool->sortIncremental(compare) : pool->sort(compare);
+        }
+
+        /**
+         * @brief Gets the group owning the pools of the given components, creating it on first use.
+         *        Entities that have every component are packed at the front of each pool, in the same order.
+         * @tparam Ts The owned component types, at least two. A pool can belong to a single group.
+         * @return The group. Iterate it with each().
+         */
+        template <Component::Component... Ts>
+        Component::Group<Ts...>& group() {
+            return components.group<Ts...>(entities);
+        }
+
+        /**
+         * @brief Collects the entities that lost a component since the running system last ran.
+         *        Removals are kept for two updates, so every system sees each removal once.
+         * @tparam T The component type.
+         * @return The entities, in removal order. Always empty in archetype mode.
+         */
+        template <Component::Component T>
+        std::vector<Entity> getRemoved() {
+            std::vector<Entity> removed;
+            if (components.getMode() == Component::Mode::Sparse) {
+                components.getPool<T>()->forEachRemoved(Component::Clock::since(), [&](const Entity& entity) { removed.push_back(entity); });
+            }
+            return removed;
+        }
+
+        /**
+         * @brief Attaches an entity to a parent, replacing its previous parent.
+         * @param child The child entity.
+         * @param parent The parent entity.
+         * @throws Exception::Type::InvalidArgument if the parent is the child or one of its descendants.
+         */
+        void setParent(const Entity& child, const Entity& parent) { hierarchy.setParent(child, parent); }
+
+        /**
+         * @brief Detaches an entity from its parent, making it a root.
+         * @param child The child entity.
+         */
+        void clearParent(const Entity& child) { hierarchy.clearParent(child); }
+
+        /**
+         * @brief Recomputes the GlobalTransform of every entity whose Transform, or an ancestor's, changed since the
+         *        previous call, in one breadth-first sweep.
+         * @warning Sparse mode only. Not thread-safe; run it from a system that writes Transform, GlobalTransform and Parent.
+         */
+        void propagateTransforms() { hierarchy.propagate(); }
+
+        /**
+         * @brief Adds a spatial grid over the entities with a position component, if missing. Bring it up to date with
+         *        Spatial::Grid::update() from a system that runs after movement, then query it from any system.
+         * @tparam P The position component: Transform without a hierarchy, GlobalTransform with one.
+         * @param cellSize The edge length of a cell, ignored if the grid exists.
+         * @return The grid, stored as a resource.
+         * @warning This function is not thread-safe; add grids before running systems.
+         */
+        template <Spatial::Positioned P = Transform>
+        Spatial::Grid<P>& addSpatialGrid(f32 cellSize) {
+            if (Spatial::Grid<P>* existing = resources.find<Spatial::Grid<P>>()) return *existing;
+            return insertResource<Spatial::Grid<P>>(entities, components, cellSize);
+        }
+
+        /**
+         * @brief Gets the spatial grid over a position component.
+         * @tparam P The position component.
+         * @return The grid, which must have been added.
+         */
+        template <Spatial::Positioned P = Transform>
+        Spatial::Grid<P>& spatialGrid() {
+            return resources.get<Spatial::Grid<P>>();
+        }
+
+        /**
+         * @brief Inserts or replaces a world-wide singleton resource. Event queues and spatial grids inserted this way
+         *        are flushed and invalidated by the world like the ones added through addEvents / addSpatialGrid.
+         * @tparam T The resource type.
+         * @tparam Args The types of the arguments to forward to the resource constructor.
+         * @param ...args The arguments to forward to the resource constructor.
+         * @return The resource.
+         * @warning This function is not thread-safe; insert resources before running systems.
+         */
+        template <typename T, typename... Args>
+        T& insertResource(Args&&... args) {
+            forget(resources.find<T>());
+            T& resource = resources.insert<T>(std::forward<Args>(args)...);
+            if constexpr (std::derived_from<T, EventsBase>) queues.push_back(&resource);
+            if constexpr (std::derived_from<T, Spatial::GridBase>) grids.push_back(&resource);
+            return resource;
+        }
+
+        /**
+         * @brief Removes a resource, if present.
+         * @tparam T The resource type.
+         */
+        template <typename T>
+        void removeResource() {
+            forget(resources.find<T>());
+            resources.remove<T>();
+        }
+
+        /**
+         * @brief Gets a resource. Systems declare access with readsResource / writesResource.
+         * @tparam T The resource type.
+         * @return The resource, which must have been inserted.
+         */
+        template <typename T>
+        T& resource() {
+            return resources.get<T>();
+        }
+
+        /**
+         * @brief Looks up a resource that may be missing.
+         * @tparam T The resource type.
+         * @return A pointer to the resource, or nullptr.
+         */
+        template <typename T>
+        T* findResource() {
+            return resources.find<T>();
+        }
+
+        /**
+         * @brief Gets the calling thread's command buffer, used to defer structural changes from parallel systems.
+         * @return The command buffer. Its commands are played back at the next sync point or flushCommands().
+         */
+        CommandBuffer& getCommands() { return commands.local(); }
+
+        /**
+         * @brief Plays back every recorded command.
+         * @warning This function is not thread-safe. The scheduler calls it at sync points and after the last stage.
+         */
+        void flushCommands() { commands.flush(); }
+
+        /**
+         * @brief Adds an event queue for a type, if missing. Its events live for two updates.
+         * @tparam T The event type.
+         * @return The queue.
+         * @warning This function is not thread-safe; add event queues before running systems.
+         */
+        template <typename T>
+        Events<T>& addEvents() {
+            if (Events<T>* existing = resources.find<Events<T>>()) return *existing;
+            return insertResource<Events<T>>();
         }
 
+        /**
+         * @brief Gets the event queue for a type.
+         * @tparam T The event type.
+         * @return The queue, which must have been added.
+         */
+        template <typename T>
+        Events<T>& events() {
+            return resources.get<Events<T>>();
+        }
+
+        /**
+         * @brief Sends an event. Readers see it after the next sync point.
+         * @tparam T The event type, whose queue must have been added.
+         * @param event The event.
+         * @note This function is thread-safe.
+         */
+        template <typename T>
+        void sendEvent(T event) {
+            events<T>().send(std::move(event));
+        }
+
+        /**
+         * @brief Publishes the events sent since the last sync point.
+         * @warning This function is not thread-safe.
+         */
+        void flushEvents() {
+            for (EventsBase* queue : queues) queue->flush();
+        }
+
+        /**
+         * @brief Plays back recorded commands, then publishes sent events.
+         * @warning This function is not thread-safe. The scheduler calls it at sync points and after the last stage.
+         */
+        void sync() {
+            flushCommands();
+            flushEvents();
+        }
+
+        /**
+         * @brief Serializes every entity and component into a compact binary snapshot. Pools of trivially copyable
+         *        components are written as one block, other components field by field through their reflected Fields.
+         *        Resources, events and pending commands are not included.
+         * @return The snapshot.
+         * @throws Exception::Type::NotSupported in archetype mode, or if a component type cannot be serialized.
+         * @warning This function is not thread-safe; call it between updates.
+         */
+        std::vector<byte> saveSnapshot() const {
+            Snapshot::Writer out;
+            out.write(Snapshot::Magic);
+            out.write(Snapshot::Version);
+            entities.save(out);
+            components.save(out);
+            return out.release();
+        }
+
+        /**
+         * @brief Replaces every entity and component with the ones in a snapshot, restoring the exact entity IDs.
+         *        Loaded components count as added.
+         * @param snapshot The snapshot, as returned by saveSnapshot().
+         * @throws Exception::Type::InvalidArgument if the snapshot is malformed or from another snapshot version.
+         * @throws Exception::Type::NotFound if a component type in the snapshot was not registered with this world.
+         * @warning This function is not thread-safe; call it between updates.
+         */
+        void loadSnapshot(std::span<const byte> snapshot) {
+            Snapshot::Reader in(snapshot);
+            if (in.read<u32>() != Snapshot::Magic || in.read<u32>() != Snapshot::Version) {
+                THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "Not a snapshot of this version");
+            }
+            entities.load(in);
+            components.load(in, entities.getSlotCount());
+            hierarchy.invalidate();
+            for (Spatial::GridBase* grid : grids) grid->invalidate();
+        }
+
+        /**
+         * @brief Makes this world's entities and components an exact copy of another world's. Arrays reuse their
+         *        capacity and trivially copyable components are copied in bulk, so repeated copies between the same
+         *        worlds (rollback checkpoints) do not allocate. Resources, events, systems and pending commands are not
+         *        copied.
+         * @param other The world to copy.
+         * @param dirtyOnly Only copy pools that either world changed since one was last copied from the other.
+         *                  Writes that bypass change detection are not noticed.
+         * @throws Exception::Type::NotSupported in archetype mode.
+         * @warning This function is not thread-safe; call it between updates.
+         */
+        void copyFrom(const World& other, b8 dirtyOnly = false) {
+            entities.copyFrom(other.entities);
+            components.copyFrom(other.components, dirtyOnly);
+            hierarchy.invalidate();
+            for (Spatial::GridBase* grid : grids) grid->invalidate();
+            previousUpdate = other.previousUpdate;
+            updates = other.updates;
+        }
+
+        /**
+         * @brief Copies the entities and the pools of some component types into a render frame, skipping pools that did
+         *        not change since the frame was last filled. Use a RenderBuffer to hand frames to the render thread.
+         * @tparam Ts The component types to extract.
+         * @param frame The frame to fill.
+         * @throws Exception::Type::NotSupported in archetype mode.
+         * @warning Not thread-safe with respect to this world; call it between updates.
+         */
+        template <Component::Component... Ts>
+        void extract(RenderFrame& frame) const {
+            frame.entities.copyFrom(entities);
+            frame.components.copyPools<Ts...>(components, true);
+            frame.sequence = updates;
+        }
+
+        /**
+         * @brief Creates a new world holding a copy of this world's entities and components, see copyFrom().
+         * @return The copy.
+         */
+        Unique<World> clone() const {
+            Unique<World> copy = MakeUnique<World>(getMode());
+            copy->copyFrom(*this);
+            return copy;
+        }
+
+        /**
+         * @brief Starts declaring a system that runs on this world.
+         * @param name The unique name of the system.
+         * @return A builder to declare the system's access and ordering. Pass the built system to addSystem().
+         */
+        System::Builder system(const std::string& name) { return System::Builder(name, components); }
+
+        /**
+         * @brief Adds a system to the world's scheduler.
+         * @param system The system to add.
+         */
+        void addSystem(System&& system) { scheduler.add(std::move(system)); }
+
+        /**
+         * @brief Inserts a sync point: every system added before it finishes before any system added after it starts.
+         */
+        void addSyncPoint() { scheduler.addSyncPoint(); }
+
+        /**
+         * @brief Sets the thread pool that non-conflicting systems run on. Systems run sequentially without one.
+         * @param pool The thread pool, or nullptr.
+         */
+        void setThreadPool(ThreadPool* pool) { this->pool = pool; }
+
+        /**
+         * @brief Runs every system once. Call this from Application::tick.
+         * @param dt The time since the last tick.
+         */
+        void update(f64 dt) {
+            const Component::Tick start = components.getClock().advance();
+            for (EventsBase* queue : queues) queue->swap();
+            scheduler.run(*this, dt, pool);
+            components.trimRemoved(previousUpdate);
+            previousUpdate = start;
+            updates++;
+        }
+
+        inline Scheduler& getScheduler() noexcept { return scheduler; }
+
+        inline u64 getUpdateCount() const noexcept { return updates; }
+
+        inline Component::Mode getMode() const noexcept { return components.getMode(); }
+
+        inline Component::Clock& getClock() noexcept { return components.getClock(); }
+
         private:
-        Component::Registry components;
+        /**
+         * @brief Stops flushing or invalidating a resource that is about to be replaced or removed.
+         * @param resource The resource, or nullptr if it is missing.
+         */
+        template <typename T>
+        void forget(T* resource) noexcept {
+            if (!resource) return;
+            if constexpr (std::derived_from<T, EventsBase>) std::erase(queues, static_cast<EventsBase*>(resource));
+            if constexpr (std::derived_from<T, Spatial::GridBase>) std::erase(grids, static_cast<Spatial::GridBase*>(resource));
+        }
+
+        Entity::Registry entities;              ///< The entities living in this world.
+        Component::Registry components;         ///< The components of every entity, in pools or archetype tables.
+        Resource::Registry resources;           ///< World-wide singleton resources.
+        Commands commands;                      ///< Per-thread deferred structural changes.
+        Hierarchy hierarchy;                    ///< Parent/child relationships and transform propagation.
+        std::vector<EventsBase*> queues;        ///< The event queues, owned by resources.
+        std::vector<Spatial::GridBase*> grids;  ///< The spatial grids, owned by resources.
+        Scheduler scheduler;                    ///< Runs the world's systems.
+        ThreadPool* pool = nullptr;             ///< The pool systems run on, if any.
+        Component::Tick previousUpdate = 0;     ///< The tick the previous update started at.
+        u64 updates = 0;                        ///< The number of completed updates.
     };
-}  // namespace iodine::core
\ No newline at end of file
+}  // namespace iodine::core
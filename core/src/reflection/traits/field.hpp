@@ -14,6 +14,7 @@ namespace iodine::core {
         public:
         inline const Type& getType() const { return type; }
         inline const char* getName() const { return name; }
+        inline u64 getOffset() const { return offset; }
 
         /**
          * @brief Gets the value of the field from the given container.
@@ -0,0 +1,49 @@
+#include "concurrency/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include "debug/exception.hpp"
+
+using namespace iodine::core;
+
+/**
+ * @brief Tests that parallelFor covers every element exactly once.
+ */
+TEST(ThreadPoolTest, ParallelForCoversRange) {
+    ThreadPool pool(4);
+    std::vector<std::atomic<int>> hits(10000);
+
+    pool.parallelFor(hits.size(), 128, [&](iodine::u64 begin, iodine::u64 end) {
+        for (iodine::u64 i = begin; i < end; i++) hits[i]++;
+    });
+
+    for (const auto& hit : hits) {
+        EXPECT_EQ(hit.load(), 1);
+    }
+}
+
+/**
+ * @brief Tests that exceptions thrown inside a chunk reach the caller.
+ */
+TEST(ThreadPoolTest, ParallelForRethrows) {
+    ThreadPool pool(2);
+    EXPECT_THROW(pool.parallelFor(100, 10,
+                                  [](iodine::u64 begin, iodine::u64) {
+                                      if (begin == 50) THROW_CORE_EXCEPTION(Exception::Type::InvalidArgument, "chunk failed");
+                                  }),
+                 Exception);
+}
+
+/**
+ * @brief Tests that parallelFor called from inside a pool task finishes even when every worker is busy.
+ */
+TEST(ThreadPoolTest, ParallelForNested) {
+    ThreadPool pool(1);
+    std::atomic<int> total = 0;
+
+    pool.parallelFor(2, 1, [&](iodine::u64, iodine::u64) {
+        pool.parallelFor(100, 10, [&](iodine::u64 begin, iodine::u64 end) { total += static_cast<int>(end - begin); });
+    });
+
+    EXPECT_EQ(total.load(), 200);
+}
@@ -0,0 +1,60 @@
+#include "concurrency/triple_buffer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace iodine::core;
+
+/**
+ * @brief Tests that the reader sees the latest published value and keeps it until the next publish.
+ */
+TEST(TripleBufferTest, ReadsLatestPublished) {
+    TripleBuffer<int> buffer;
+    EXPECT_FALSE(buffer.hasUpdate());
+    EXPECT_EQ(buffer.read(), 0);
+
+    buffer.getWriteBuffer() = 1;
+    buffer.publish();
+    buffer.getWriteBuffer() = 2;
+    buffer.publish();
+    EXPECT_TRUE(buffer.hasUpdate());
+    EXPECT_EQ(buffer.read(), 2);
+    EXPECT_FALSE(buffer.hasUpdate());
+    EXPECT_EQ(buffer.read(), 2);
+
+    buffer.getWriteBuffer() = 3;
+    EXPECT_EQ(buffer.read(), 2);
+    buffer.publish();
+    EXPECT_EQ(buffer.read(), 3);
+}
+
+/**
+ * @brief Tests that a reader running alongside a writer only ever sees complete values, in publish order.
+ */
+TEST(TripleBufferTest, ConcurrentHandoff) {
+    struct Pair {
+        iodine::u64 first = 0;
+        iodine::u64 second = 0;
+    };
+    TripleBuffer<Pair> buffer;
+    constexpr iodine::u64 Count = 100000;
+
+    std::thread writer([&] {
+        for (iodine::u64 i = 1; i <= Count; i++) {
+            Pair& pair = buffer.getWriteBuffer();
+            pair.first = i;
+            pair.second = i * 2;
+            buffer.publish();
+        }
+    });
+
+    iodine::u64 last = 0;
+    while (last < Count) {
+        const Pair& pair = buffer.read();
+        ASSERT_EQ(pair.second, pair.first * 2);
+        ASSERT_GE(pair.first, last);
+        last = pair.first;
+    }
+    writer.join();
+}
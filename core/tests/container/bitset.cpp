@@ -85,7 +85,23 @@ TEST(BitSetDeathTest, MismatchedCapacityAssertion) {
 
     EXPECT_DEATH({ small |= big; }, "");
     EXPECT_DEATH({ small &= big; }, "");
-    EXPECT_FALSE(small.intersects(big));  // safe: function early-returns
+    EXPECT_FALSE(small.intersects(big));  // no bits set on either side
+}
+
+TEST(BitSetFunctionalityTest, IntersectsAcrossCapacities) {
+    BitSet<iodine::u64, 64> small;
+    BitSet<iodine::u64, 64> big;
+    small.set(5);
+    big.set(5);
+    big.set(300);
+
+    EXPECT_TRUE(small.intersects(big));
+    EXPECT_TRUE(big.intersects(small));
+
+    small.reset(5);
+    EXPECT_FALSE(big.intersects(small));
+    small.set(300);
+    EXPECT_TRUE(small.intersects(big));
 }
 
 TEST(BitSetFunctionalityTest, CopyAndMove) {
@@ -98,4 +114,61 @@ TEST(BitSetFunctionalityTest, CopyAndMove) {
 
     BitSet<iodine::u32> moved(std::move(a));
     EXPECT_EQ(moved.count(), 2u);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Tests that equality and hashing ignore spill capacity.
+ */
+TEST(BitSetFunctionalityTest, EqualityAndHash) {
+    BitSet<iodine::u64> a, b;
+    a.set(5);
+    b.set(5);
+    b.resize(2048);
+
+    EXPECT_TRUE(a == b);
+    EXPECT_EQ(a.hash(), b.hash());
+
+    b.set(BigId);
+    EXPECT_TRUE(a != b);
+    EXPECT_TRUE(b.includes(a));
+    EXPECT_FALSE(a.includes(b));
+}
+
+/**
+ * @brief Tests that forEach visits every set bit in ascending order.
+ */
+TEST(BitSetFunctionalityTest, ForEachSetBit) {
+    BitSet<iodine::u64> mask;
+    mask.set(0);
+    mask.set(63);
+    mask.set(64);
+    mask.set(BigId);
+
+    std::vector<iodine::u64> bits;
+    mask.forEach([&](iodine::u64 bit) { bits.push_back(bit); });
+    EXPECT_EQ(bits, (std::vector<iodine::u64>{0, 63, 64, BigId}));
+}
+
+/**
+ * @brief Tests the combined include / exclude check, including spilled bits and differing capacities.
+ */
+TEST(BitSetFunctionalityTest, MatchesIncludeExclude) {
+    BitSet<iodine::u64> mask;
+    mask.set(3);
+    mask.set(BigId);
+
+    BitSet<iodine::u64> include;
+    BitSet<iodine::u64> exclude;
+    include.set(3);
+    EXPECT_TRUE(mask.matches(include, exclude));
+
+    exclude.set(4);
+    EXPECT_TRUE(mask.matches(include, exclude));
+    exclude.set(BigId);
+    EXPECT_FALSE(mask.matches(include, exclude));
+
+    exclude.reset(BigId);
+    include.set(BigId + 64);
+    EXPECT_FALSE(mask.matches(include, exclude));
+    EXPECT_TRUE(mask.matches(BitSet<iodine::u64>{}, BitSet<iodine::u64>{}));
+}
@@ -0,0 +1,67 @@
+#include "container/chunked_vector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <string>
+
+using namespace iodine::core;
+
+struct Particle {
+    float position[3];
+    float velocity[3];
+};
+
+/**
+ * @brief Tests that growing never moves existing elements and that every chunk is aligned and fits the chunk size.
+ */
+TEST(ChunkedVectorTest, GrowthKeepsAddresses) {
+    ChunkedVector<Particle> particles;
+    STATIC_ASSERT(ChunkedVector<Particle>::ChunkCapacity * sizeof(Particle) <= 16384, "Chunks must fit 16 KiB");
+    STATIC_ASSERT(std::has_single_bit(ChunkedVector<Particle>::ChunkCapacity), "Chunk capacity must be a power of two");
+
+    particles.push_back(Particle{{1.0f, 2.0f, 3.0f}, {}});
+    const Particle* first = &particles[0];
+    for (int i = 1; i < 5000; i++) particles.emplace_back(Particle{{static_cast<float>(i), 0.0f, 0.0f}, {}});
+
+    EXPECT_EQ(&particles[0], first);
+    EXPECT_EQ(particles.size(), 5000u);
+    EXPECT_FLOAT_EQ(particles[4999].position[0], 4999.0f);
+    EXPECT_EQ(particles.getChunkCount(), (5000 + ChunkedVector<Particle>::ChunkCapacity - 1) / ChunkedVector<Particle>::ChunkCapacity);
+
+    iodine::u64 total = 0;
+    for (iodine::u64 chunk = 0; chunk < particles.getChunkCount(); chunk++) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(particles.getChunk(chunk).data()) % 64, 0u);
+        total += particles.getChunk(chunk).size();
+    }
+    EXPECT_EQ(total, 5000u);
+}
+
+/**
+ * @brief Tests iteration, popping, resizing and copying, with elements that own memory.
+ */
+TEST(ChunkedVectorTest, ElementLifetimes) {
+    ChunkedVector<std::string, 256> names;
+    for (int i = 0; i < 100; i++) names.push_back("name" + std::to_string(i));
+    names.pop_back();
+    EXPECT_EQ(names.size(), 99u);
+    EXPECT_EQ(names[98], "name98");
+
+    ChunkedVector<std::string, 256> copy = names;
+    names[0] = "changed";
+    EXPECT_EQ(copy[0], "name0");
+    EXPECT_EQ(std::count_if(copy.begin(), copy.end(), [](const std::string& name) { return name.starts_with("name"); }), 99);
+
+    copy.resize(10);
+    EXPECT_EQ(copy.size(), 10u);
+    copy.resize(12);
+    EXPECT_TRUE(copy[11].empty());
+
+    ChunkedVector<int, 64> numbers;
+    numbers.resize(50);
+    std::iota(numbers.begin(), numbers.end(), 0);
+    std::sort(numbers.begin(), numbers.end(), std::greater<>());
+    EXPECT_EQ(numbers[0], 49);
+    EXPECT_EQ(std::accumulate(numbers.begin(), numbers.end(), 0), 49 * 50 / 2);
+}
@@ -2,6 +2,8 @@
 
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 using namespace iodine::core;
 
 struct TestStruct {
@@ -254,3 +256,77 @@ TEST(SparseSetFunctionalityTest, SwapOnlyAffectsRawBuffer) {
     EXPECT_EQ(set.at(1), 10);
     EXPECT_EQ(set.at(2), 20);
 }
+
+/**
+ * @brief Tests that sparse pages are only allocated for populated index ranges.
+ */
+TEST(SparseSetFunctionalityTest, PagedIndices) {
+    SparseSet<int> set;
+    const iodine::u64 high = (1ull << 28) + 7;
+    set.insert(3, 30);
+    set.insert(high, 70);
+    set.insert(high + 1, 71);
+
+    EXPECT_EQ(set.getPageCount(), 2u);
+    EXPECT_EQ(set.at(high), 70);
+    EXPECT_FALSE(set.contains(high - 1));
+    EXPECT_FALSE(set.contains(SparseSet<int>::PageSize));
+
+    set.erase(3);
+    EXPECT_FALSE(set.contains(3));
+    EXPECT_EQ(set.at(high + 1), 71);
+
+    SparseSet<int> copy = set;
+    set.erase(high);
+    EXPECT_EQ(copy.at(high), 70);
+    EXPECT_EQ(copy.getSize(), 2u);
+}
+
+/**
+ * @brief Tests full and incremental sorting keep indices and values paired.
+ */
+TEST(SparseSetFunctionalityTest, Sort) {
+    SparseSet<int> set;
+    const int values[] = {50, 10, 40, 30, 20};
+    for (iodine::u64 i = 0; i < 5; i++) set.insert(i * 7, values[i]);
+
+    set.sort([](int left, int right) { return left < right; });
+    auto [data, size] = set.getData();
+    for (iodine::u64 i = 1; i < size; i++) EXPECT_LT(data[i - 1], data[i]);
+    for (iodine::u64 i = 0; i < 5; i++) EXPECT_EQ(set.at(i * 7), values[i]);
+    for (iodine::u64 i = 0; i < size; i++) EXPECT_EQ(set.at(set.getIndices()[i]), data[i]);
+
+    set.at(0) = 5;
+    set.sortIncremental([](int left, int right) { return left < right; });
+    EXPECT_EQ(set.getData().first[0], 5);
+    EXPECT_EQ(set.getIndices()[0], 0u);
+    for (iodine::u64 i = 0; i < 5; i++) EXPECT_EQ(set.getPosition(set.getIndices()[i]), i);
+}
+
+/**
+ * @brief Tests a chunked sparse set: batches spanning chunk boundaries, erasure, and block-wise access.
+ */
+TEST(SparseSetTest, ChunkedStorage) {
+    SparseSet<iodine::u64, true> set;
+    constexpr iodine::u64 Count = SparseSet<iodine::u64, true>::ChunkCapacity * 2 + 17;
+    set.insert(Count, Count);
+    const iodine::u64* first = set.find(Count);
+
+    std::vector<iodine::u64> indices(Count);
+    std::iota(indices.begin(), indices.end(), 0);
+    set.insertBatch(indices, indices.data());
+    EXPECT_EQ(set.find(Count), first);
+    for (iodine::u64 index = 0; index <= Count; index++) EXPECT_EQ(set.at(index), index);
+
+    set.erase(3);
+    EXPECT_FALSE(set.contains(3));
+    iodine::u64 total = 0;
+    iodine::u64 values = 0;
+    set.forEachBlock([&](const iodine::u64* block, iodine::u64 count) {
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block) % 64, 0u);
+        for (iodine::u64 i = 0; i < count; i++) total += block[i];
+        values += count;
+    });
+    EXPECT_EQ(values, Count);
+    EXPECT_EQ(total, Count * (Count + 1) / 2 - 3);
+}
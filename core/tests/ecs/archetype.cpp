@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Velocity {
+    float dx, dy;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Velocity, "Velocity", Fields().with("dx", &Velocity::dx).with("dy", &Velocity::dy));
+
+struct Health {
+    int hp;
+    std::string label;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Health, "Health");
+
+/**
+ * @brief Tests that entities move between tables as components are added and removed, keeping their data.
+ */
+TEST(ArchetypeRegistryTest, MigrateBetweenTables) {
+    World world(Component::Mode::Archetype);
+    Entity e1 = world.createEntity();
+    Entity e2 = world.createEntity();
+
+    world.addComponent<Velocity>(e1, 1.0f, 2.0f);
+    world.addComponent<Velocity>(e2, 3.0f, 4.0f);
+    world.addComponent<Health>(e1, 10, std::string("first"));
+
+    EXPECT_TRUE(world.hasComponent<Velocity>(e1));
+    EXPECT_TRUE(world.hasComponent<Health>(e1));
+    EXPECT_FALSE(world.hasComponent<Health>(e2));
+    EXPECT_FLOAT_EQ(world.getComponent<Velocity>(e1).dx, 1.0f);
+    EXPECT_FLOAT_EQ(world.getComponent<Velocity>(e2).dy, 4.0f);
+    EXPECT_EQ(world.getComponent<Health>(e1).label, "first");
+
+    world.removeComponent<Velocity>(e1);
+    EXPECT_FALSE(world.hasComponent<Velocity>(e1));
+    EXPECT_EQ(world.getComponent<Health>(e1).hp, 10);
+    EXPECT_EQ(world.getComponent<Health>(e1).label, "first");
+    EXPECT_FLOAT_EQ(world.getComponent<Velocity>(e2).dx, 3.0f);
+}
+
+/**
+ * @brief Tests that entities with the same component set share one table with contiguous columns.
+ */
+TEST(ArchetypeRegistryTest, ContiguousColumns) {
+    Component::Registry registry(Component::Mode::Archetype);
+    Entity::Registry entities;
+    const Component::ID velocity = registry.enter<Velocity>();
+
+    for (int i = 0; i < 100; i++) {
+        Entity e = entities.create();
+        registry.create<Velocity>(e, static_cast<float>(i), 0.0f);
+        if (i % 2 == 0) registry.create<Health>(e, i, std::string("even"));
+    }
+
+    Component::Signature required;
+    required.set(velocity);
+    int tables = 0;
+    float sum = 0.0f;
+    registry.getArchetypes().forEachTable(required, [&](Archetype::Table& table) {
+        tables++;
+        Velocity* data = table.getData<Velocity>(velocity);
+        for (iodine::u64 row = 0; row < table.getSize(); row++) {
+            sum += data[row].dx;
+        }
+    });
+    EXPECT_EQ(tables, 2);
+    EXPECT_FLOAT_EQ(sum, 4950.0f);
+}
+
+/**
+ * @brief Tests that destroying an entity frees its row and keeps the moved entity addressable.
+ */
+TEST(ArchetypeRegistryTest, DestroyKeepsOtherRows) {
+    World world(Component::Mode::Archetype);
+    Entity e1 = world.createEntity();
+    Entity e2 = world.createEntity();
+    Entity e3 = world.createEntity();
+    world.addComponent<Velocity>(e1, 1.0f, 1.0f);
+    world.addComponent<Velocity>(e2, 2.0f, 2.0f);
+    world.addComponent<Velocity>(e3, 3.0f, 3.0f);
+
+    world.destroyEntity(e1);
+    EXPECT_FALSE(world.isAlive(e1));
+    EXPECT_FLOAT_EQ(world.getComponent<Velocity>(e2).dx, 2.0f);
+    EXPECT_FLOAT_EQ(world.getComponent<Velocity>(e3).dx, 3.0f);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Heading {
+    float angle;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Heading, "Heading", Fields().with("angle", &Heading::angle));
+
+/**
+ * @brief Tests that a system sees changes made since its previous run, but not its own writes.
+ */
+TEST(ChangeTest, ChangedSinceLastRun) {
+    World world;
+    Entity a = world.createEntity();
+    Entity b = world.createEntity();
+    world.addComponent<Heading>(a, 0.0f);
+    world.addComponent<Heading>(b, 0.0f);
+
+    int added = 0;
+    int changed = 0;
+    world.addSystem(world.system("watch").writes<Heading>().build([&](World& w, iodine::f64) {
+        added = changed = 0;
+        w.view<const Heading, Added<Heading>>().each([&](const Heading&) { added++; });
+        w.view<Heading, Changed<Heading>>().each([&](Heading& heading) {
+            heading.angle += 1.0f;
+            changed++;
+        });
+    }));
+
+    world.update(0.0);
+    EXPECT_EQ(added, 2);
+    EXPECT_EQ(changed, 2);
+
+    world.update(0.0);
+    EXPECT_EQ(added, 0);
+    EXPECT_EQ(changed, 0);
+
+    world.getComponent<Heading>(b).angle = 3.0f;
+    Entity c = world.createEntity();
+    world.addComponent<Heading>(c, 1.0f);
+    world.update(0.0);
+    EXPECT_EQ(added, 1);
+    EXPECT_EQ(changed, 2);
+
+    std::as_const(world).getComponent<Heading>(a);
+    world.view<const Heading>().each([](const Heading&) {});
+    world.update(0.0);
+    EXPECT_EQ(changed, 0);
+}
+
+/**
+ * @brief Tests that writes by one system are seen by another system on its next run.
+ */
+TEST(ChangeTest, ChangesCrossSystems) {
+    World world;
+    Entity e = world.createEntity();
+    world.addComponent<Heading>(e, 0.0f);
+
+    int seen = 0;
+    world.addSystem(world.system("reader").reads<Heading>().build([&](World& w, iodine::f64) {
+        seen = 0;
+        w.view<const Heading, Changed<Heading>>().each([&](const Heading&) { seen++; });
+    }));
+    world.addSystem(world.system("writer").writes<Heading>().after("reader").build([&](World& w, iodine::f64) {
+        w.view<Heading>().each([](Heading& heading) { heading.angle += 1.0f; });
+    }));
+
+    world.update(0.0);
+    EXPECT_EQ(seen, 1);
+    world.update(0.0);
+    EXPECT_EQ(seen, 1);
+}
+
+/**
+ * @brief Tests that writes from parallel workers carry the system's tick, so the system does not see them next run.
+ */
+TEST(ChangeTest, ParallelWritesUseSystemTick) {
+    World world;
+    for (int i = 0; i < 4000; i++) world.addComponent<Heading>(world.createEntity(), 0.0f);
+
+    ThreadPool pool(3);
+    int changed = 0;
+    world.addSystem(world.system("spin").writes<Heading>().build([&](World& w, iodine::f64) {
+        changed = 0;
+        w.view<const Heading, Changed<Heading>>().each([&](const Heading&) { changed++; });
+        w.view<Heading>().forEachParallel(pool, [](Heading& heading) { heading.angle += 1.0f; }, 128);
+    }));
+
+    world.update(0.0);
+    EXPECT_EQ(changed, 4000);
+    world.update(0.0);
+    EXPECT_EQ(changed, 0);
+}
+
+/**
+ * @brief Tests that removals are reported once per system and then forgotten.
+ */
+TEST(ChangeTest, RemovedSinceLastRun) {
+    World world;
+    Entity e = world.createEntity();
+    world.addComponent<Heading>(e, 0.0f);
+
+    std::vector<Entity> removed;
+    world.addSystem(world.system("watch").reads<Heading>().build([&](World& w, iodine::f64) { removed = w.getRemoved<Heading>(); }));
+
+    world.update(0.0);
+    EXPECT_TRUE(removed.empty());
+
+    world.removeComponent<Heading>(e);
+    world.update(0.0);
+    ASSERT_EQ(removed.size(), 1u);
+    EXPECT_EQ(removed[0], e);
+
+    world.update(0.0);
+    EXPECT_TRUE(removed.empty());
+}
+
+/**
+ * @brief Tests that change filters are rejected in archetype mode.
+ */
+TEST(ChangeTest, ArchetypeUnsupported) {
+    World world(Component::Mode::Archetype);
+    EXPECT_THROW((world.view<Heading, Changed<Heading>>()), Exception);
+}
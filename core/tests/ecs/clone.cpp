@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/external/primitives.hpp"
+#include "reflection/external/string.hpp"
+
+using namespace iodine::core;
+
+struct Ammo {
+    iodine::u32 count;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Ammo, "Ammo", Fields().with("count", &Ammo::count));
+
+struct Callsign {
+    std::string name;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Callsign, "Callsign", Fields().with("name", &Callsign::name));
+
+/**
+ * @brief Tests that a clone holds the same entities and components and is independent of the original.
+ */
+TEST(CloneTest, CloneIsIndependent) {
+    World world;
+    const Entity first = world.createEntity();
+    const Entity second = world.createEntity();
+    world.addComponent<Ammo>(first, Ammo{10});
+    world.addComponent<Callsign>(second, Callsign{"viper"});
+
+    iodine::Unique<World> copy = world.clone();
+    EXPECT_TRUE(copy->isAlive(first));
+    EXPECT_EQ(copy->getComponent<Ammo>(first).count, 10u);
+    EXPECT_EQ(copy->getComponent<Callsign>(second).name, "viper");
+    EXPECT_FALSE(copy->hasComponent<Ammo>(second));
+
+    world.getComponent<Ammo>(first).count = 3;
+    world.destroyEntity(second);
+    EXPECT_EQ(copy->getComponent<Ammo>(first).count, 10u);
+    EXPECT_TRUE(copy->isAlive(second));
+    EXPECT_EQ(world.createEntity().getIndex(), second.getIndex());
+}
+
+/**
+ * @brief Tests rolling back repeatedly to a checkpoint world.
+ */
+TEST(CloneTest, RepeatedRollback) {
+    World live;
+    const Entity ship = live.createEntity();
+    live.addComponent<Ammo>(ship, Ammo{8});
+    World checkpoint;
+    checkpoint.copyFrom(live);
+
+    for (int step = 0; step < 8; step++) {
+        live.getComponent<Ammo>(ship).count -= 1;
+        const Entity shot = live.createEntity();
+        live.addComponent<Callsign>(shot, Callsign{"shot"});
+
+        live.copyFrom(checkpoint, true);
+        EXPECT_EQ(live.getComponent<Ammo>(ship).count, 8u);
+        EXPECT_FALSE(live.isAlive(shot));
+        EXPECT_FALSE(live.hasComponent<Callsign>(shot));
+    }
+}
+
+/**
+ * @brief Tests that dirty-only copies skip pools neither side changed since they were last synchronized.
+ */
+TEST(CloneTest, DirtyOnlySkipsCleanPools) {
+    Entity::Registry entities;
+    const Entity entity = entities.create();
+    Component::Registry source;
+    Component::Registry target;
+    source.create<Ammo>(entity, Ammo{1});
+    source.create<Callsign>(entity, Callsign{"a"});
+    target.copyFrom(source);
+
+    // An untracked write is not seen, so the clean pool is not copied over it.
+    target.getPool<Ammo>()->getAt(0).count = 99;
+    source.get<Callsign>(entity).name = "b";
+    target.copyFrom(source, true);
+    EXPECT_EQ(target.get<Ammo>(entity).count, 99u);
+    EXPECT_EQ(target.get<Callsign>(entity).name, "b");
+
+    // A full copy always copies.
+    target.copyFrom(source);
+    EXPECT_EQ(std::as_const(target).get<Ammo>(entity).count, 1u);
+}
+
+/**
+ * @brief Tests that groups are packed again after their pools were copied.
+ */
+TEST(CloneTest, GroupsRepacked) {
+    World source;
+    World target;
+    target.group<Ammo, Callsign>();
+    for (int i = 0; i < 6; i++) {
+        const Entity entity = source.createEntity();
+        source.addComponent<Ammo>(entity, Ammo{static_cast<iodine::u32>(i)});
+        if (i % 2) source.addComponent<Callsign>(entity, Callsign{"odd"});
+    }
+
+    target.copyFrom(source);
+    Component::Group<Ammo, Callsign>& group = target.group<Ammo, Callsign>();
+    EXPECT_EQ(group.getSize(), 3u);
+    group.each([](Ammo& ammo, Callsign& callsign) {
+        EXPECT_EQ(ammo.count % 2, 1u);
+        EXPECT_EQ(callsign.name, "odd");
+    });
+}
+
+/**
+ * @brief Tests that writes through a parallel view mark the pool dirty for the next dirty-only copy.
+ */
+TEST(CloneTest, ParallelWritesAreDirty) {
+    World live;
+    for (int i = 0; i < 5000; i++) live.addComponent<Ammo>(live.createEntity(), Ammo{1});
+    World checkpoint;
+    checkpoint.copyFrom(live);
+
+    ThreadPool pool(3);
+    live.view<Ammo>().forEachParallel(pool, [](Ammo& ammo) { ammo.count = 2; }, 256);
+    checkpoint.copyFrom(live, true);
+
+    iodine::u64 total = 0;
+    checkpoint.view<const Ammo>().each([&](const Ammo& ammo) { total += ammo.count; });
+    EXPECT_EQ(total, 10000u);
+}
@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Projectile {
+    float damage;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Projectile, "Projectile", Fields().with("damage", &Projectile::damage));
+
+struct Tagline {
+    std::string text;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Tagline, "Tagline");
+
+class CommandTest : public ::testing::TestWithParam<Component::Mode> {};
+
+/**
+ * @brief Tests that recorded commands only take effect when flushed, in recording order per type.
+ */
+TEST_P(CommandTest, DeferredUntilFlush) {
+    World world(GetParam());
+    CommandBuffer& commands = world.getCommands();
+
+    Entity e = commands.spawn();
+    commands.add<Projectile>(e, 5.0f);
+    commands.add<Tagline>(e, std::string("a fairly long string that does not fit in small buffers"));
+    commands.remove<Projectile>(e);
+    commands.add<Projectile>(e, 7.0f);
+    EXPECT_FALSE(world.hasComponent<Projectile>(e));
+
+    world.flushCommands();
+    EXPECT_FLOAT_EQ(world.getComponent<Projectile>(e).damage, 7.0f);
+    EXPECT_EQ(world.getComponent<Tagline>(e).text, "a fairly long string that does not fit in small buffers");
+
+    commands.destroy(e);
+    world.flushCommands();
+    EXPECT_FALSE(world.isAlive(e));
+}
+
+/**
+ * @brief Tests that systems running in parallel can spawn through their thread's buffer.
+ */
+TEST_P(CommandTest, ParallelSystemsSpawn) {
+    World world(GetParam());
+    ThreadPool pool(3);
+    world.setThreadPool(&pool);
+
+    for (int i = 0; i < 4; i++) {
+        world.addSystem(world.system("spawner" + std::to_string(i)).build([](World& w, iodine::f64) {
+            CommandBuffer& commands = w.getCommands();
+            for (int j = 0; j < 1000; j++) commands.add<Projectile>(commands.spawn(), 1.0f);
+        }));
+    }
+    world.update(0.0);
+
+    int count = 0;
+    world.view<Projectile>().each([&](const Projectile&) { count++; });
+    EXPECT_EQ(count, 4000);
+}
+
+INSTANTIATE_TEST_SUITE_P(StorageModes, CommandTest, ::testing::Values(Component::Mode::Sparse, Component::Mode::Archetype));
@@ -2,6 +2,7 @@
 
 #include "ecs/component/registry.hpp"
 #include "ecs/entity/registry.hpp"
+#include "ecs/world.hpp"
 #include "reflection/traits/field.hpp"
 
 using namespace iodine::core;
@@ -14,6 +15,13 @@ struct Position {
 };
 IO_REFLECT_IMPL(Position, "Position", Fields().with("x", &Position::x).with("y", &Position::y));
 
+struct Scale {
+    float factor;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Scale, "Scale", Fields().with("factor", &Scale::factor));
+
 TEST(ComponentRegistryTest, CreateDestroyReuse) {
     Entity::Registry entityRegistry;
     // Create a dummy entity with index 0
@@ -49,3 +57,125 @@ TEST(ComponentRegistryTest, CreateDestroyReuse) {
         EXPECT_FLOAT_EQ(p2.y, 4.0f);
     }
 }
+
+/**
+ * @brief Tests that batch insertion copies the component to every new entity and skips existing ones.
+ */
+TEST(ComponentRegistryTest, CreateBatch) {
+    Entity::Registry entityRegistry;
+    std::vector<Entity> batch;
+    entityRegistry.createBatch(1000, std::back_inserter(batch));
+
+    Component::Registry componentRegistry;
+    componentRegistry.create<Position>(batch[5], Position{9.0f, 9.0f});
+    componentRegistry.createBatch<Position>(batch, Position{1.0f, 2.0f});
+
+    EXPECT_EQ(componentRegistry.getPool<Position>()->getSize(), 1000u);
+    EXPECT_FLOAT_EQ(componentRegistry.get<Position>(batch[5]).x, 9.0f);
+    EXPECT_FLOAT_EQ(componentRegistry.get<Position>(batch[999]).y, 2.0f);
+}
+
+/**
+ * @brief Tests that component masks track membership and that destroy clears exactly the entity's pools.
+ */
+TEST(ComponentRegistryTest, MasksAndDestroy) {
+    Entity::Registry entityRegistry;
+    Entity a = entityRegistry.create();
+    Entity b = entityRegistry.create();
+
+    Component::Registry componentRegistry;
+    componentRegistry.create<Position>(a, Position{1.0f, 1.0f});
+    componentRegistry.create<Scale>(a, Scale{2.0f});
+    componentRegistry.create<Position>(b, Position{3.0f, 3.0f});
+
+    EXPECT_TRUE((componentRegistry.has<Position, Scale>(a)));
+    EXPECT_FALSE((componentRegistry.has<Position, Scale>(b)));
+    EXPECT_TRUE(componentRegistry.has<Position>(b));
+    EXPECT_EQ(componentRegistry.getMask(a).count(), 2u);
+
+    componentRegistry.destroy(a);
+    EXPECT_FALSE(componentRegistry.has<Position>(a));
+    EXPECT_EQ(componentRegistry.getPool<Position>()->getSize(), 1u);
+    EXPECT_EQ(componentRegistry.getPool<Scale>()->getSize(), 0u);
+    EXPECT_FLOAT_EQ(componentRegistry.get<Position>(b).x, 3.0f);
+}
+
+/**
+ * @brief Tests that destroying through a stale handle leaves the entity that recycled its index untouched.
+ */
+TEST(ComponentRegistryTest, StaleDestroyIgnored) {
+    World world;
+    const Entity stale = world.createEntity();
+    world.destroyEntity(stale);
+    const Entity fresh = world.createEntity();
+    ASSERT_EQ(fresh.getIndex(), stale.getIndex());
+    world.addComponent<Position>(fresh, Position{1.0f, 2.0f});
+
+    world.destroyEntity(stale);
+    const Entity batch[] = {stale};
+    world.destroyEntities(batch);
+    EXPECT_TRUE(world.isAlive(fresh));
+    EXPECT_TRUE(world.hasComponent<Position>(fresh));
+    EXPECT_FLOAT_EQ(world.getComponent<Position>(fresh).y, 2.0f);
+}
+
+/**
+ * @brief Tests that registries share component IDs but keep independent pools.
+ */
+TEST(ComponentRegistryTest, IndependentRegistries) {
+    Entity::Registry entityRegistry;
+    Entity entity = entityRegistry.create();
+
+    Component::Registry first;
+    Component::Registry second;
+    EXPECT_EQ(first.enter<Position>(), second.enter<Position>());
+    EXPECT_NE(first.enter<Position>(), first.enter<Scale>());
+
+    first.create<Position>(entity, Position{1.0f, 0.0f});
+    second.create<Position>(entity, Position{2.0f, 0.0f});
+    EXPECT_NE(first.getPool<Position>(), second.getPool<Position>());
+    EXPECT_FLOAT_EQ(first.get<Position>(entity).x, 1.0f);
+    EXPECT_FLOAT_EQ(second.get<Position>(entity).x, 2.0f);
+}
+
+/**
+ * @brief Tests compile-time type hashes and collision detection at registration.
+ */
+TEST(ComponentRegistryTest, CompileTimeTypeIds) {
+    constexpr iodine::u64 position = Component::Types::hash<Position>();
+    constexpr iodine::u64 scale = Component::Types::hash<Scale>();
+    STATIC_ASSERT(position != scale, "Distinct types must hash differently");
+
+    const Component::ID id = Component::Types::of<Position>();
+    EXPECT_EQ(Component::Types::assign(position, "Position"), id);
+    EXPECT_THROW(Component::Types::assign(position, "Impostor"), Exception);
+
+    const Component::Signature& both = Component::Types::signatureOf<Position, Scale>();
+    EXPECT_TRUE(both.test(id));
+    EXPECT_TRUE(both.test(Component::Types::of<Scale>()));
+    EXPECT_EQ(both.count(), 2u);
+}
+
+/**
+ * @brief Tests that a pool can follow the order of another pool.
+ */
+TEST(ComponentRegistryTest, SortAs) {
+    Entity::Registry entityRegistry;
+    std::vector<Entity> batch;
+    entityRegistry.createBatch(6, std::back_inserter(batch));
+
+    Component::Registry componentRegistry;
+    for (iodine::u64 i = 0; i < 6; i++) componentRegistry.create<Position>(batch[i], Position{static_cast<float>(6 - i), 0.0f});
+    for (iodine::u64 i = 1; i < 6; i += 2) componentRegistry.create<Scale>(batch[i], Scale{1.0f});
+
+    Component::Pool<Position>* positions = componentRegistry.getPool<Position>();
+    Component::Pool<Scale>* scales = componentRegistry.getPool<Scale>();
+    positions->sort([](const Position& left, const Position& right) { return left.x < right.x; });
+    scales->sortAs(*positions);
+
+    EXPECT_EQ(scales->getIndices()[0], batch[5].getIndex());
+    EXPECT_EQ(scales->getIndices()[1], batch[3].getIndex());
+    EXPECT_EQ(scales->getIndices()[2], batch[1].getIndex());
+    EXPECT_FLOAT_EQ(positions->getAt(0).x, 1.0f);
+    EXPECT_NE(scales->getStamp(batch[5].getIndex()), nullptr);
+}
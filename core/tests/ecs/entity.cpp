@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
 
+#include <set>
+#include <thread>
+
 #include "ecs/entity/registry.hpp"
 
 using namespace iodine::core;
@@ -83,4 +86,64 @@ TEST(EntityRegistryTest, DestroyInDifferentOrder) {
     // e3 is still alive and should be distinct from newly created entities
     EXPECT_NE(e3, e4);
     EXPECT_NE(e3, e5);
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Tests that batch creation reuses destroyed slots before appending fresh ones.
+ */
+TEST(EntityRegistryTest, BatchCreateDestroy) {
+    Entity::Registry registry;
+
+    std::vector<Entity> first;
+    registry.createBatch(100, std::back_inserter(first));
+    ASSERT_EQ(first.size(), 100u);
+    for (const Entity& entity : first) EXPECT_TRUE(registry.isAlive(entity));
+
+    registry.destroyBatch(std::span<const Entity>(first).subspan(10, 20));
+    for (iodine::u64 i = 10; i < 30; i++) EXPECT_FALSE(registry.isAlive(first[i]));
+    EXPECT_TRUE(registry.isAlive(first[30]));
+
+    std::vector<Entity> second;
+    registry.createBatch(30, std::back_inserter(second));
+    for (iodine::u64 i = 0; i < 20; i++) {
+        EXPECT_EQ(second[i].getIndex(), first[10 + i].getIndex());
+        EXPECT_EQ(second[i].getVersion(), first[10 + i].getVersion() + 1);
+    }
+    for (iodine::u64 i = 20; i < 30; i++) EXPECT_EQ(second[i].getIndex(), 80 + i);
+
+    Entity single = registry.create();
+    EXPECT_EQ(single.getIndex(), 110u);
+}
+
+/**
+ * @brief Tests that concurrent creation and destruction never hands out the same live entity twice.
+ */
+TEST(EntityRegistryTest, ConcurrentCreateDestroy) {
+    Entity::Registry registry;
+    constexpr int threads = 4;
+    std::vector<std::vector<Entity>> kept(threads);
+
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t] {
+            for (int round = 0; round < 50; round++) {
+                std::vector<Entity> batch;
+                registry.createBatch(100, std::back_inserter(batch));
+                for (int i = 0; i < 50; i++) registry.destroy(batch[i]);
+                registry.destroyBatch(std::span<const Entity>(batch).subspan(50, 40));
+                for (int i = 90; i < 100; i++) kept[t].push_back(batch[i]);
+                kept[t].push_back(registry.create());
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+    std::set<iodine::u64> indices;
+    for (const auto& entities : kept) {
+        for (const Entity& entity : entities) {
+            EXPECT_TRUE(registry.isAlive(entity));
+            EXPECT_TRUE(indices.insert(entity.getIndex()).second);
+        }
+    }
+    EXPECT_EQ(indices.size(), static_cast<size_t>(threads * 50 * 11));
+}
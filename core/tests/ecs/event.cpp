@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "ecs/world.hpp"
+
+using namespace iodine::core;
+
+struct Collision {
+    int first;
+    int second;
+};
+
+/**
+ * @brief Tests that events become readable after a sync point and that each reader sees them exactly once.
+ */
+TEST(EventTest, ReadersSeeEachEventOnce) {
+    World world;
+    Events<Collision>& events = world.addEvents<Collision>();
+    Events<Collision>::Reader a, b;
+
+    world.sendEvent(Collision{1, 2});
+    std::vector<int> seen;
+    events.read(a, [&](const Collision& event) { seen.push_back(event.first); });
+    EXPECT_TRUE(seen.empty());
+
+    world.flushEvents();
+    world.sendEvent(Collision{3, 4});
+    world.flushEvents();
+    events.read(a, [&](const Collision& event) { seen.push_back(event.first); });
+    EXPECT_EQ(seen, (std::vector<int>{1, 3}));
+    events.read(a, [&](const Collision& event) { seen.push_back(event.first); });
+    EXPECT_EQ(seen.size(), 2u);
+
+    int count = 0;
+    events.read(b, [&](const Collision&) { count++; });
+    EXPECT_EQ(count, 2);
+}
+
+/**
+ * @brief Tests that events survive one swap, are dropped after two, and that late readers skip what was dropped.
+ */
+TEST(EventTest, DoubleBuffered) {
+    World world;
+    Events<Collision>& events = world.addEvents<Collision>();
+    Events<Collision>::Reader reader;
+
+    events.send({1, 0});
+    events.flush();
+    events.swap();
+    events.send({2, 0});
+    events.flush();
+    EXPECT_EQ(events.getCount(), 2u);
+
+    std::vector<int> seen;
+    events.read(reader, [&](const Collision& event) { seen.push_back(event.first); });
+    EXPECT_EQ(seen, (std::vector<int>{1, 2}));
+
+    events.swap();
+    events.swap();
+    events.send({3, 0});
+    events.flush();
+    EXPECT_EQ(events.getCount(), 1u);
+
+    Events<Collision>::Reader late;
+    seen.clear();
+    events.read(late, [&](const Collision& event) { seen.push_back(event.first); });
+    EXPECT_EQ(seen, (std::vector<int>{3}));
+
+    Events<Collision>::Reader fresh = events.latest();
+    int count = 0;
+    events.read(fresh, [&](const Collision&) { count++; });
+    EXPECT_EQ(count, 0);
+}
+
+/**
+ * @brief Tests that events sent from several threads are all published.
+ */
+TEST(EventTest, ConcurrentWriters) {
+    World world;
+    Events<Collision>& events = world.addEvents<Collision>();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([&, t] {
+            for (int i = 0; i < 1000; i++) events.send({t, i});
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    world.flushEvents();
+
+    Events<Collision>::Reader reader;
+    std::vector<int> perThread(4, 0);
+    events.read(reader, [&](const Collision& event) { perThread[event.first]++; });
+    EXPECT_EQ(perThread, (std::vector<int>(4, 1000)));
+}
+
+/**
+ * @brief Tests that systems see events sent by earlier stages across updates.
+ */
+TEST(EventTest, SystemsAcrossUpdates) {
+    World world;
+    world.addEvents<Collision>();
+    Events<Collision>::Reader reader;
+    int received = 0;
+
+    world.addSystem(world.system("send").build([](World& w, iodine::f64) { w.sendEvent(Collision{0, 0}); }));
+    world.addSyncPoint();
+    world.addSystem(world.system("receive").build([&](World& w, iodine::f64) { w.events<Collision>().read(reader, [&](const Collision&) { received++; }); }));
+
+    world.update(0.0);
+    EXPECT_EQ(received, 1);
+    world.update(0.0);
+    EXPECT_EQ(received, 2);
+}
+
+/**
+ * @brief Tests that replacing or removing an event queue resource leaves no stale queue behind.
+ */
+TEST(EventTest, ReplaceAndRemoveQueue) {
+    World world;
+    world.addEvents<Collision>();
+    world.sendEvent(Collision{1, 2});
+
+    Events<Collision>& replaced = world.insertResource<Events<Collision>>();
+    world.sendEvent(Collision{5, 6});
+    world.update(0.0);
+    Events<Collision>::Reader reader;
+    std::vector<int> seen;
+    replaced.read(reader, [&](const Collision& event) { seen.push_back(event.first); });
+    EXPECT_EQ(seen, (std::vector<int>{5}));
+
+    world.removeResource<Events<Collision>>();
+    world.update(0.0);
+    world.flushEvents();
+    EXPECT_EQ(world.findResource<Events<Collision>>(), nullptr);
+}
@@ -0,0 +1,153 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Spin {
+    float rate;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Spin, "Spin", Fields().with("rate", &Spin::rate));
+
+struct Drift {
+    float offset;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Drift, "Drift", Fields().with("offset", &Drift::offset));
+
+struct Bulk {
+    float weight;
+    float padding[63];
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Bulk, "Bulk", Fields().with("weight", &Bulk::weight));
+
+template <>
+inline constexpr iodine::b8 Component::Chunked<Bulk> = true;
+
+struct Pinned {
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Pinned, "Pinned");
+
+/**
+ * @brief Checks that exactly the entities with both components sit, in the same order, at the front of both pools.
+ */
+static void expectPacked(Component::Registry& components, Component::Group<Spin, Drift>& group) {
+    Component::Pool<Spin>* spins = components.getPool<Spin>();
+    Component::Pool<Drift>* drifts = components.getPool<Drift>();
+
+    iodine::u64 members = 0;
+    for (iodine::u64 position = 0; position < spins->getSize(); position++) {
+        if (drifts->find(spins->getIndices()[position])) members++;
+    }
+    ASSERT_EQ(group.getSize(), members);
+    for (iodine::u64 position = 0; position < group.getSize(); position++) {
+        EXPECT_EQ(spins->getIndices()[position], drifts->getIndices()[position]);
+    }
+}
+
+/**
+ * @brief Tests that a group packs existing and new members and keeps them packed through removals.
+ */
+TEST(GroupTest, KeepsMembersPacked) {
+    Entity::Registry entities;
+    Component::Registry components;
+
+    std::vector<Entity> all;
+    entities.createBatch(100, std::back_inserter(all));
+    for (iodine::u64 i = 0; i < all.size(); i++) {
+        components.create<Spin>(all[i], Spin{1.0f});
+        if (i % 3 == 0) components.create<Drift>(all[i], Drift{static_cast<float>(i)});
+    }
+
+    auto& group = components.group<Spin, Drift>(entities);
+    EXPECT_EQ(&group, &(components.group<Spin, Drift>(entities)));
+    expectPacked(components, group);
+    EXPECT_EQ(group.getSize(), 34u);
+
+    for (iodine::u64 i = 1; i < all.size(); i += 3) components.create<Drift>(all[i], Drift{0.0f});
+    expectPacked(components, group);
+    EXPECT_EQ(group.getSize(), 67u);
+
+    for (iodine::u64 i = 0; i < all.size(); i += 6) components.remove<Spin>(all[i]);
+    components.destroy(all[1]);
+    expectPacked(components, group);
+    EXPECT_EQ(group.getSize(), 67u - 17u - 1u);
+
+    EXPECT_THROW((components.group<Drift, Spin>(entities)), Exception);
+}
+
+/**
+ * @brief Tests lockstep iteration through the world.
+ */
+TEST(GroupTest, EachInLockstep) {
+    World world;
+    for (int i = 0; i < 10; i++) {
+        Entity entity = world.createEntity();
+        world.addComponent<Spin>(entity, 2.0f);
+        if (i % 2 == 0) world.addComponent<Drift>(entity, 1.0f);
+    }
+
+    auto& group = world.group<Spin, Drift>();
+    float total = 0.0f;
+    group.each([&](Spin& spin, Drift& drift) {
+        drift.offset += spin.rate;
+        total += drift.offset;
+    });
+    EXPECT_FLOAT_EQ(total, 15.0f);
+
+    int visited = 0;
+    group.each([&](Entity entity, Spin&, Drift&) {
+        EXPECT_TRUE(world.isAlive(entity));
+        visited++;
+    });
+    EXPECT_EQ(visited, 5);
+}
+
+/**
+ * @brief Tests lockstep iteration when an owned pool is stored in chunks.
+ */
+TEST(GroupTest, EachAcrossChunks) {
+    World world;
+    for (int i = 0; i < 2000; i++) {
+        Entity entity = world.createEntity();
+        world.addComponent<Bulk>(entity, Bulk{1.0f, {}});
+        world.addComponent<Drift>(entity, static_cast<float>(i));
+    }
+
+    auto& group = world.group<Bulk, Drift>();
+    ASSERT_GT(group.getSize(), Component::Pool<Bulk>::ChunkCapacity);
+    float total = 0.0f;
+    group.each([&](Entity entity, Bulk& bulk, Drift& drift) {
+        EXPECT_FLOAT_EQ(drift.offset, static_cast<float>(entity.getIndex()));
+        total += bulk.weight;
+    });
+    EXPECT_FLOAT_EQ(total, 2000.0f);
+}
+
+/**
+ * @brief Tests lockstep iteration when one of the owned types is a tag.
+ */
+TEST(GroupTest, EachWithTag) {
+    World world;
+    for (int i = 0; i < 100; i++) {
+        Entity entity = world.createEntity();
+        world.addComponent<Drift>(entity, static_cast<float>(i));
+        if (i % 4 == 0) world.addComponent<Pinned>(entity);
+    }
+
+    auto& group = world.group<Drift, Pinned>();
+    EXPECT_EQ(group.getSize(), 25u);
+    float total = 0.0f;
+    group.each([&](Entity entity, Drift& drift, Pinned&) {
+        EXPECT_FLOAT_EQ(drift.offset, static_cast<float>(entity.getIndex()));
+        total += drift.offset;
+    });
+    EXPECT_FLOAT_EQ(total, 1200.0f);
+}
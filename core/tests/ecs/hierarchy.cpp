@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "ecs/world.hpp"
+
+using namespace iodine::core;
+
+static Transform translated(float x, float y, float z) {
+    Transform transform;
+    transform.x = x;
+    transform.y = y;
+    transform.z = z;
+    return transform;
+}
+
+/**
+ * @brief Tests that world transforms compose translation, rotation and scale down a chain.
+ */
+TEST(HierarchyTest, PropagatesDownChains) {
+    World world;
+    const Entity root = world.createEntity();
+    const Entity arm = world.createEntity();
+    const Entity hand = world.createEntity();
+
+    Transform turned = translated(10.0f, 0.0f, 0.0f);
+    turned.qz = std::sqrt(0.5f);  // 90 degrees around Z.
+    turned.qw = std::sqrt(0.5f);
+    turned.scale = 2.0f;
+    world.addComponent<Transform>(root, turned);
+    world.addComponent<Transform>(arm, translated(1.0f, 0.0f, 0.0f));
+    world.addComponent<Transform>(hand, translated(0.0f, 1.0f, 0.0f));
+    world.setParent(hand, arm);
+    world.setParent(arm, root);
+    world.propagateTransforms();
+
+    const GlobalTransform& armGlobal = world.getComponent<GlobalTransform>(arm);
+    EXPECT_NEAR(armGlobal.x, 10.0f, 1e-5f);
+    EXPECT_NEAR(armGlobal.y, 2.0f, 1e-5f);
+    EXPECT_FLOAT_EQ(armGlobal.scale, 2.0f);
+
+    const GlobalTransform& handGlobal = world.getComponent<GlobalTransform>(hand);
+    EXPECT_NEAR(handGlobal.x, 8.0f, 1e-5f);
+    EXPECT_NEAR(handGlobal.y, 2.0f, 1e-5f);
+}
+
+/**
+ * @brief Tests that the flattened order is breadth-first and that both pools are laid out in it.
+ */
+TEST(HierarchyTest, BreadthFirstOrder) {
+    Entity::Registry entities;
+    Component::Registry components;
+    Hierarchy hierarchy(entities, components);
+    std::vector<Entity> nodes;
+    for (int i = 0; i < 6; i++) nodes.push_back(entities.create());
+    // Leaves first, so the pool starts out in the wrong order.
+    for (int i = 5; i >= 0; i--) components.create<Transform>(nodes[i], translated(1.0f, 0.0f, 0.0f));
+    hierarchy.setParent(nodes[1], nodes[0]);
+    hierarchy.setParent(nodes[2], nodes[0]);
+    hierarchy.setParent(nodes[3], nodes[1]);
+    hierarchy.setParent(nodes[4], nodes[3]);
+    hierarchy.setParent(nodes[5], nodes[2]);
+    hierarchy.propagate();
+
+    // Global x equals depth, so depths must never decrease along the order; siblings keep pool order.
+    const std::vector<iodine::u64>& order = hierarchy.getOrder();
+    ASSERT_EQ(order.size(), nodes.size());
+    EXPECT_EQ(order[0], nodes[0].getIndex());
+    for (iodine::u64 node = 0; node < order.size(); node++) {
+        EXPECT_EQ(components.getPool<Transform>()->getIndices()[node], order[node]);
+        EXPECT_EQ(components.getPool<GlobalTransform>()->getIndices()[node], order[node]);
+        if (node > 0) {
+            EXPECT_LE(components.getPool<GlobalTransform>()->getAt(node - 1).x, components.getPool<GlobalTransform>()->getAt(node).x);
+        }
+    }
+    EXPECT_FLOAT_EQ(components.getPool<GlobalTransform>()->find(nodes[4].getIndex())->x, 4.0f);
+}
+
+/**
+ * @brief Tests that only subtrees below a changed transform are recomputed.
+ */
+TEST(HierarchyTest, OnlyDirtySubtrees) {
+    Entity::Registry entities;
+    Component::Registry components;
+    Hierarchy hierarchy(entities, components);
+    const Entity left = entities.create();
+    const Entity right = entities.create();
+    const Entity leaf = entities.create();
+    components.create<Transform>(left, translated(1.0f, 0.0f, 0.0f));
+    components.create<Transform>(right, translated(2.0f, 0.0f, 0.0f));
+    components.create<Transform>(leaf, translated(0.0f, 1.0f, 0.0f));
+    hierarchy.setParent(leaf, left);
+    hierarchy.propagate();
+
+    Component::Pool<GlobalTransform>* globals = components.getPool<GlobalTransform>();
+    const Component::Tick rightStamp = globals->getStamp(right.getIndex())->changed;
+    const Component::Tick leafStamp = globals->getStamp(leaf.getIndex())->changed;
+
+    components.getClock().advance();
+    components.get<Transform>(left).x = 5.0f;
+    hierarchy.propagate();
+    EXPECT_FLOAT_EQ(globals->find(leaf.getIndex())->x, 5.0f);
+    EXPECT_GT(globals->getStamp(leaf.getIndex())->changed, leafStamp);
+    EXPECT_EQ(globals->getStamp(right.getIndex())->changed, rightStamp);
+}
+
+/**
+ * @brief Tests reparenting, detaching, cycle rejection and destroyed parents.
+ */
+TEST(HierarchyTest, Relationships) {
+    World world;
+    const Entity a = world.createEntity();
+    const Entity b = world.createEntity();
+    const Entity c = world.createEntity();
+    world.addComponent<Transform>(a, translated(1.0f, 0.0f, 0.0f));
+    world.addComponent<Transform>(b, translated(10.0f, 0.0f, 0.0f));
+    world.addComponent<Transform>(c, translated(100.0f, 0.0f, 0.0f));
+    world.setParent(b, a);
+    world.setParent(c, b);
+    EXPECT_THROW(world.setParent(a, c), Exception);
+    EXPECT_THROW(world.setParent(a, a), Exception);
+
+    world.propagateTransforms();
+    EXPECT_FLOAT_EQ(world.getComponent<GlobalTransform>(c).x, 111.0f);
+
+    world.setParent(c, a);
+    world.propagateTransforms();
+    EXPECT_FLOAT_EQ(world.getComponent<GlobalTransform>(c).x, 101.0f);
+
+    world.clearParent(c);
+    world.propagateTransforms();
+    EXPECT_FLOAT_EQ(world.getComponent<GlobalTransform>(c).x, 100.0f);
+
+    world.destroyEntity(a);
+    world.propagateTransforms();
+    EXPECT_FLOAT_EQ(world.getComponent<GlobalTransform>(b).x, 10.0f);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Armor {
+    float rating;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Armor, "Armor", Fields().with("rating", &Armor::rating));
+
+struct Shield {
+    float charge;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Shield, "Shield", Fields().with("charge", &Shield::charge));
+
+struct Wrecked {
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Wrecked, "Wrecked");
+
+class QueryTest : public ::testing::TestWithParam<Component::Mode> {};
+
+/**
+ * @brief Tests that a query created before any entity exists picks up entities and component combinations that
+ *        appear later.
+ */
+TEST_P(QueryTest, SeesLaterEntitiesAndCombinations) {
+    World world(GetParam());
+    Query<const Armor, Without<Wrecked>> query = world.query<const Armor, Without<Wrecked>>();
+    int visited = 0;
+    query.each([&](const Armor&) { visited++; });
+    EXPECT_EQ(visited, 0);
+
+    std::vector<Entity> spawned;
+    for (int i = 0; i < 12; i++) {
+        spawned.push_back(world.createEntity());
+        world.addComponent<Armor>(spawned.back(), 1.0f);
+    }
+    query.each([&](const Armor&) { visited++; });
+    EXPECT_EQ(visited, 12);
+
+    // New combinations: Armor + Shield matches, Armor + Wrecked does not.
+    for (int i = 0; i < 12; i += 3) world.addComponent<Shield>(spawned[i], 0.0f);
+    for (int i = 1; i < 12; i += 3) world.addComponent<Wrecked>(spawned[i]);
+    visited = 0;
+    for (auto [entity, armor] : query.get()) {
+        EXPECT_FALSE(world.hasComponent<Wrecked>(entity));
+        visited++;
+    }
+    EXPECT_EQ(visited, 8);
+}
+
+INSTANTIATE_TEST_SUITE_P(StorageModes, QueryTest, ::testing::Values(Component::Mode::Sparse, Component::Mode::Archetype));
+
+/**
+ * @brief Tests that a query captured by a system filters changes against that system's previous run.
+ */
+TEST(QueryChangeTest, FollowsRunningSystem) {
+    World world;
+    const Entity entity = world.createEntity();
+    world.addComponent<Shield>(entity, 0.0f);
+
+    int changed = 0;
+    world.addSystem(world.system("recharge").reads<Shield>().build([&, query = world.query<const Shield, Changed<Shield>>()](World&, iodine::f64) mutable {
+        changed = 0;
+        query.each([&](const Shield&) { changed++; });
+    }));
+
+    world.update(0.0);
+    EXPECT_EQ(changed, 1);
+    world.update(0.0);
+    EXPECT_EQ(changed, 0);
+    world.getComponent<Shield>(entity).charge = 1.0f;
+    world.update(0.0);
+    EXPECT_EQ(changed, 1);
+}
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "ecs/render/buffer.hpp"
+#include "reflection/external/primitives.hpp"
+
+using namespace iodine::core;
+
+struct Sprite {
+    iodine::u32 frame;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Sprite, "Sprite", Fields().with("frame", &Sprite::frame));
+
+struct Velocity2 {
+    iodine::f32 x;
+    iodine::f32 y;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Velocity2, "Velocity2", Fields().with("x", &Velocity2::x).with("y", &Velocity2::y));
+
+/**
+ * @brief Tests that a frame holds the extracted pools only and does not follow later world changes.
+ */
+TEST(RenderTest, ExtractCopiesSelectedPools) {
+    World world;
+    const Entity first = world.createEntity();
+    const Entity second = world.createEntity();
+    world.addComponent<Sprite>(first, Sprite{1});
+    world.addComponent<Sprite>(second, Sprite{2});
+    world.addComponent<Velocity2>(first, Velocity2{1.0f, 0.0f});
+    world.update(0.0);
+
+    RenderFrame frame;
+    world.extract<Sprite>(frame);
+    EXPECT_EQ(frame.getSequence(), 1u);
+    EXPECT_EQ(frame.find<Sprite>(second)->frame, 2u);
+    EXPECT_EQ(frame.find<Velocity2>(first), nullptr);
+
+    world.getComponent<Sprite>(first).frame = 7;
+    world.destroyEntity(second);
+    iodine::u32 total = 0;
+    frame.view<Sprite>().each([&](Sprite& sprite) { total += sprite.frame; });
+    EXPECT_EQ(total, 3u);
+
+    world.extract<Sprite>(frame);
+    EXPECT_EQ(frame.find<Sprite>(first)->frame, 7u);
+    EXPECT_EQ(frame.find<Sprite>(second), nullptr);
+}
+
+/**
+ * @brief Tests that a render buffer hands the latest frame over and skips unchanged pools on refill.
+ */
+TEST(RenderTest, BufferPublishesLatest) {
+    World world;
+    const Entity entity = world.createEntity();
+    world.addComponent<Sprite>(entity, Sprite{0});
+    RenderBuffer<Sprite> buffer;
+    EXPECT_EQ(buffer.read().find<Sprite>(entity), nullptr);
+
+    for (iodine::u32 i = 1; i <= 5; i++) {
+        world.getComponent<Sprite>(entity).frame = i;
+        world.update(0.0);
+        buffer.publish(world);
+    }
+    EXPECT_TRUE(buffer.hasUpdate());
+    const RenderFrame& frame = buffer.read();
+    EXPECT_EQ(frame.getSequence(), 5u);
+    EXPECT_EQ(frame.find<Sprite>(entity)->frame, 5u);
+}
+
+/**
+ * @brief Tests a tick thread publishing while a render thread reads.
+ */
+TEST(RenderTest, ConcurrentTickAndRender) {
+    World world;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 64; i++) {
+        entities.push_back(world.createEntity());
+        world.addComponent<Sprite>(entities.back(), Sprite{0});
+    }
+    RenderBuffer<Sprite> buffer;
+    constexpr iodine::u32 Ticks = 200;
+
+    std::thread tick([&] {
+        for (iodine::u32 t = 1; t <= Ticks; t++) {
+            for (Entity entity : entities) world.getComponent<Sprite>(entity).frame = t;
+            world.update(0.0);
+            buffer.publish(world);
+        }
+    });
+
+    iodine::u64 last = 0;
+    while (last < Ticks) {
+        const RenderFrame& frame = buffer.read();
+        ASSERT_GE(frame.getSequence(), last);
+        last = frame.getSequence();
+        frame.view<Sprite>().each([&](Sprite& sprite) { ASSERT_EQ(sprite.frame, last); });
+    }
+    tick.join();
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+
+using namespace iodine::core;
+
+struct GameClock {
+    double elapsed = 0.0;
+};
+
+struct Settings {
+    int quality;
+};
+
+static System::Function noop() {
+    return [](World&, iodine::f64) {};
+}
+
+/**
+ * @brief Tests inserting, replacing, reading and removing resources.
+ */
+TEST(ResourceTest, InsertAndLookup) {
+    World world;
+    EXPECT_EQ(world.findResource<GameClock>(), nullptr);
+
+    world.insertResource<GameClock>();
+    world.insertResource<Settings>(Settings{2});
+    world.resource<GameClock>().elapsed += 1.5;
+    EXPECT_DOUBLE_EQ(world.resource<GameClock>().elapsed, 1.5);
+    EXPECT_EQ(world.resource<Settings>().quality, 2);
+
+    world.insertResource<Settings>(Settings{3});
+    EXPECT_EQ(world.resource<Settings>().quality, 3);
+
+    world.removeResource<GameClock>();
+    EXPECT_EQ(world.findResource<GameClock>(), nullptr);
+    EXPECT_NE(Resource::Types::of<GameClock>(), Resource::Types::of<Settings>());
+}
+
+/**
+ * @brief Tests that two resource types hashing alike are rejected at registration.
+ */
+TEST(ResourceTest, TypeHashCollision) {
+    constexpr iodine::u64 hash = Component::Types::hash<GameClock>();
+    const Resource::ID id = Resource::Types::of<GameClock>();
+    EXPECT_EQ(Resource::Types::assign(hash, Component::Types::signature<GameClock>()), id);
+    EXPECT_THROW(Resource::Types::assign(hash, Component::Types::signature<Settings>()), Exception);
+}
+
+/**
+ * @brief Tests that resource access is taken into account when staging systems.
+ */
+TEST(ResourceTest, SchedulerSeesAccess) {
+    World world;
+    world.addSystem(world.system("tick").writesResource<GameClock>().build(noop()));
+    world.addSystem(world.system("read").readsResource<GameClock>().build(noop()));
+    world.addSystem(world.system("settings").readsResource<Settings, GameClock>().after("tick").build(noop()));
+    world.addSystem(world.system("other").readsResource<Settings>().build(noop()));
+
+    const auto& stages = world.getScheduler().getStages();
+    ASSERT_EQ(stages.size(), 2u);
+    EXPECT_EQ(stages[0], (std::vector<iodine::u64>{0, 3}));
+    EXPECT_EQ(stages[1], (std::vector<iodine::u64>{1, 2}));
+}
@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/external/primitives.hpp"
+#include "reflection/external/string.hpp"
+
+using namespace iodine::core;
+
+struct Waypoint {
+    iodine::f32 x;
+    iodine::i32 order;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Waypoint, "Waypoint", Fields().with("x", &Waypoint::x).with("order", &Waypoint::order));
+
+struct Nameplate {
+    std::string text;
+    iodine::u32 color = 0;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Nameplate, "Nameplate", Fields().with("text", &Nameplate::text).with("color", &Nameplate::color));
+
+struct Hidden {
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Hidden, "Hidden");
+
+struct Heading {
+    explicit Heading(iodine::f32 angle) : angle(angle) {}
+    iodine::f32 angle;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Heading, "Heading", Fields().with("angle", &Heading::angle));
+
+/**
+ * @brief Registers the component types used by these tests.
+ */
+static void registerAll(World& world) {
+    world.registerComponent<Waypoint>();
+    world.registerComponent<Nameplate>();
+    world.registerComponent<Hidden>();
+    world.registerComponent<Heading>();
+}
+
+/**
+ * @brief Tests that a snapshot loaded into a fresh world reproduces entity IDs, components and the free list.
+ */
+TEST(SnapshotTest, RoundTrip) {
+    World source;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 5; i++) entities.push_back(source.createEntity());
+    for (int i = 0; i < 5; i++) source.addComponent<Waypoint>(entities[i], Waypoint{i * 1.5f, i});
+    source.addComponent<Nameplate>(entities[1], Nameplate{"a rather long name that does not fit inline", 7});
+    source.addComponent<Hidden>(entities[3]);
+    source.addComponent<Heading>(entities[4], Heading{0.5f});
+    source.destroyEntity(entities[2]);
+
+    const std::vector<iodine::byte> snapshot = source.saveSnapshot();
+
+    World target;
+    registerAll(target);
+    target.loadSnapshot(snapshot);
+
+    EXPECT_FALSE(target.isAlive(entities[2]));
+    for (int i : {0, 1, 3, 4}) {
+        ASSERT_TRUE(target.isAlive(entities[i]));
+        EXPECT_FLOAT_EQ(target.getComponent<Waypoint>(entities[i]).x, i * 1.5f);
+        EXPECT_EQ(target.getComponent<Waypoint>(entities[i]).order, i);
+    }
+    EXPECT_EQ(target.getComponent<Nameplate>(entities[1]).text, "a rather long name that does not fit inline");
+    EXPECT_EQ(target.getComponent<Nameplate>(entities[1]).color, 7u);
+    EXPECT_TRUE(target.hasComponent<Hidden>(entities[3]));
+    EXPECT_FALSE(target.hasComponent<Hidden>(entities[4]));
+    EXPECT_FLOAT_EQ(target.getComponent<Heading>(entities[4]).angle, 0.5f);
+    EXPECT_FALSE(target.hasComponent<Nameplate>(entities[0]));
+
+    // Both worlds recycle the same index next.
+    EXPECT_EQ(source.createEntity(), target.createEntity());
+
+    int seen = 0;
+    target.view<Waypoint, Hidden>().each([&](Waypoint& waypoint) {
+        EXPECT_EQ(waypoint.order, 3);
+        seen++;
+    });
+    EXPECT_EQ(seen, 1);
+}
+
+/**
+ * @brief Tests rolling a world back to a checkpoint.
+ */
+TEST(SnapshotTest, Rollback) {
+    World world;
+    registerAll(world);
+    const Entity kept = world.createEntity();
+    world.addComponent<Waypoint>(kept, Waypoint{1.0f, 1});
+    const std::vector<iodine::byte> checkpoint = world.saveSnapshot();
+
+    world.getComponent<Waypoint>(kept).x = 99.0f;
+    world.addComponent<Hidden>(kept);
+    const Entity later = world.createEntity();
+    world.addComponent<Waypoint>(later, Waypoint{2.0f, 2});
+
+    world.loadSnapshot(checkpoint);
+    EXPECT_TRUE(world.isAlive(kept));
+    EXPECT_FALSE(world.isAlive(later));
+    EXPECT_FLOAT_EQ(world.getComponent<Waypoint>(kept).x, 1.0f);
+    EXPECT_FALSE(world.hasComponent<Hidden>(kept));
+
+    int count = 0;
+    world.view<Waypoint>().each([&](Waypoint&) { count++; });
+    EXPECT_EQ(count, 1);
+}
+
+/**
+ * @brief Tests that malformed snapshots, unknown component types and archetype worlds are rejected.
+ */
+TEST(SnapshotTest, Errors) {
+    World source;
+    source.addComponent<Waypoint>(source.createEntity(), Waypoint{0.0f, 0});
+    std::vector<iodine::byte> snapshot = source.saveSnapshot();
+
+    World unregistered;
+    EXPECT_THROW(unregistered.loadSnapshot(snapshot), Exception);
+
+    World target;
+    registerAll(target);
+    snapshot.resize(snapshot.size() - 1);
+    EXPECT_THROW(target.loadSnapshot(snapshot), Exception);
+    snapshot[0] = 0;
+    EXPECT_THROW(target.loadSnapshot(snapshot), Exception);
+
+    World archetypes(Component::Mode::Archetype);
+    EXPECT_THROW(archetypes.saveSnapshot(), Exception);
+}
+
+/**
+ * @brief Tests that a pool rejects a component count larger than the snapshot, repeated entity indices and indices
+ *        past the loaded entity registry.
+ */
+TEST(SnapshotTest, CorruptPool) {
+    Component::Clock clock;
+
+    Snapshot::Writer oversized;
+    oversized.write<iodine::u64>(iodine::u64(1) << 61);
+    oversized.write<iodine::u64>(0);
+    const std::vector<iodine::byte> oversizedBytes = oversized.release();
+    Snapshot::Reader oversizedIn(oversizedBytes);
+    Component::Pool<Waypoint> first(clock);
+    EXPECT_THROW(first.load(oversizedIn, 16), Exception);
+
+    Snapshot::Writer duplicate;
+    duplicate.write<iodine::u64>(2);
+    duplicate.write<iodine::u64>(3);
+    duplicate.write<iodine::u64>(3);
+    duplicate.write(Waypoint{1.0f, 1});
+    duplicate.write(Waypoint{2.0f, 2});
+    const std::vector<iodine::byte> duplicateBytes = duplicate.release();
+    Snapshot::Reader duplicateIn(duplicateBytes);
+    Component::Pool<Waypoint> second(clock);
+    EXPECT_THROW(second.load(duplicateIn, 16), Exception);
+    EXPECT_EQ(second.getSize(), 0u);
+
+    Snapshot::Writer outOfRange;
+    outOfRange.write<iodine::u64>(1);
+    outOfRange.write<iodine::u64>(iodine::u64(1) << 40);
+    outOfRange.write(Waypoint{1.0f, 1});
+    const std::vector<iodine::byte> outOfRangeBytes = outOfRange.release();
+    Snapshot::Reader outOfRangeIn(outOfRangeBytes);
+    Component::Pool<Waypoint> third(clock);
+    EXPECT_THROW(third.load(outOfRangeIn, 16), Exception);
+    EXPECT_EQ(third.getSize(), 0u);
+}
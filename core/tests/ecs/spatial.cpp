@@ -0,0 +1,194 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "ecs/world.hpp"
+
+using namespace iodine::core;
+
+/**
+ * @brief Collects the indices of some entities, sorted, for order-independent comparisons.
+ */
+static std::vector<iodine::u64> sortedIndices(const std::vector<Entity>& found) {
+    std::vector<iodine::u64> indices;
+    for (const Entity& entity : found) indices.push_back(entity.getIndex());
+    std::ranges::sort(indices);
+    return indices;
+}
+
+/**
+ * @brief Squared distance between a transform and a point.
+ */
+static iodine::f32 distanceSquared(const Transform& transform, const Spatial::Point& point) {
+    const iodine::f32 dx = transform.x - point.x, dy = transform.y - point.y, dz = transform.z - point.z;
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief Tests box, radius and k-nearest queries against a brute-force scan.
+ */
+TEST(SpatialTest, QueriesMatchBruteForce) {
+    World world;
+    Spatial::Grid<Transform>& grid = world.addSpatialGrid(4.0f);
+    std::mt19937 random(7);
+    std::uniform_real_distribution<iodine::f32> coordinate(-50.0f, 50.0f);
+    std::vector<std::pair<Entity, Transform>> placed;
+    for (int i = 0; i < 2000; i++) {
+        const Entity entity = world.createEntity();
+        Transform transform;
+        transform.x = coordinate(random);
+        transform.y = coordinate(random);
+        transform.z = coordinate(random) * 0.1f;
+        world.addComponent<Transform>(entity, transform);
+        placed.emplace_back(entity, transform);
+    }
+    grid.update();
+    EXPECT_EQ(grid.getSize(), placed.size());
+
+    for (int query = 0; query < 20; query++) {
+        const Spatial::Point center{coordinate(random), coordinate(random), 0.0f};
+        const Spatial::Point min{center.x - 6.0f, center.y - 3.0f, -2.0f};
+        const Spatial::Point max{center.x + 6.0f, center.y + 3.0f, 2.0f};
+        std::vector<Entity> inBox, inRadius, nearest;
+        grid.queryBox(min, max, inBox);
+        grid.queryRadius(center, 9.0f, inRadius);
+        grid.queryNearest(center, 10, nearest);
+
+        std::vector<Entity> expectedBox, expectedRadius;
+        std::vector<std::pair<iodine::f32, iodine::u64>> byDistance;
+        for (const auto& [entity, t] : placed) {
+            if (t.x >= min.x && t.x <= max.x && t.y >= min.y && t.y <= max.y && t.z >= min.z && t.z <= max.z) expectedBox.push_back(entity);
+            if (distanceSquared(t, center) <= 81.0f) expectedRadius.push_back(entity);
+            byDistance.emplace_back(distanceSquared(t, center), entity.getIndex());
+        }
+        std::ranges::sort(byDistance);
+
+        EXPECT_EQ(sortedIndices(inBox), sortedIndices(expectedBox));
+        EXPECT_EQ(sortedIndices(inRadius), sortedIndices(expectedRadius));
+        ASSERT_EQ(nearest.size(), 10u);
+        for (iodine::u64 i = 0; i < nearest.size(); i++) EXPECT_EQ(nearest[i].getIndex(), byDistance[i].second);
+    }
+}
+
+/**
+ * @brief Tests that queries over a sparse world with a distant outlier stay exact and scan occupied cells only.
+ */
+TEST(SpatialTest, DistantOutlier) {
+    World world;
+    Spatial::Grid<Transform>& grid = world.addSpatialGrid(1.0f);
+    std::vector<Entity> placed;
+    for (int i = 0; i < 4; i++) {
+        const Entity entity = world.createEntity();
+        Transform transform;
+        transform.x = static_cast<iodine::f32>(i);
+        world.addComponent<Transform>(entity, transform);
+        placed.push_back(entity);
+    }
+    const Entity outlier = world.createEntity();
+    Transform far;
+    far.x = 1000.0f;
+    far.y = -1000.0f;
+    far.z = 1000.0f;
+    world.addComponent<Transform>(outlier, far);
+    grid.update();
+
+    std::vector<Entity> nearest;
+    grid.queryNearest({0.0f, 0.0f, 0.0f}, 100, nearest);
+    ASSERT_EQ(nearest.size(), 5u);
+    for (iodine::u64 i = 0; i < placed.size(); i++) EXPECT_EQ(nearest[i], placed[i]);
+    EXPECT_EQ(nearest.back(), outlier);
+
+    std::vector<Entity> inBox;
+    grid.queryBox({-2000.0f, -2000.0f, -2000.0f}, {2000.0f, 2000.0f, 2000.0f}, inBox);
+    EXPECT_EQ(inBox.size(), 5u);
+}
+
+/**
+ * @brief Tests that updates follow moved, removed and destroyed entities.
+ */
+TEST(SpatialTest, IncrementalUpdate) {
+    World world;
+    Spatial::Grid<Transform>& grid = world.addSpatialGrid(1.0f);
+    const Entity mover = world.createEntity();
+    const Entity dropped = world.createEntity();
+    const Entity destroyed = world.createEntity();
+    world.addComponent<Transform>(mover, Transform{});
+    world.addComponent<Transform>(dropped, Transform{});
+    world.addComponent<Transform>(destroyed, Transform{});
+    grid.update();
+
+    std::vector<Entity> found;
+    grid.queryRadius({0.0f, 0.0f, 0.0f}, 0.5f, found);
+    EXPECT_EQ(found.size(), 3u);
+
+    world.getComponent<Transform>(mover).x = 10.0f;
+    world.removeComponent<Transform>(dropped);
+    world.destroyEntity(destroyed);
+    const Entity added = world.createEntity();
+    Transform transform;
+    transform.x = 10.5f;
+    world.addComponent<Transform>(added, transform);
+    grid.update();
+    EXPECT_EQ(grid.getSize(), 2u);
+
+    found.clear();
+    grid.queryRadius({0.0f, 0.0f, 0.0f}, 0.5f, found);
+    EXPECT_TRUE(found.empty());
+    grid.queryNearest({10.0f, 0.0f, 0.0f}, 5, found);
+    ASSERT_EQ(found.size(), 2u);
+    EXPECT_EQ(found[0], mover);
+    EXPECT_EQ(found[1], added);
+
+    found.clear();
+    grid.queryNearest({0.0f, 0.0f, 0.0f}, 5, found, 5.0f);
+    EXPECT_TRUE(found.empty());
+}
+
+/**
+ * @brief Tests that restoring a world rebuilds its grids.
+ */
+TEST(SpatialTest, RollbackRebuilds) {
+    World world;
+    Spatial::Grid<Transform>& grid = world.addSpatialGrid(2.0f);
+    const Entity entity = world.createEntity();
+    world.addComponent<Transform>(entity, Transform{});
+    grid.update();
+    World checkpoint;
+    checkpoint.copyFrom(world);
+
+    world.getComponent<Transform>(entity).y = 30.0f;
+    grid.update();
+    world.copyFrom(checkpoint, true);
+    grid.update();
+
+    std::vector<Entity> found;
+    grid.queryBox({-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}, found);
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0], entity);
+    EXPECT_THROW(world.addSpatialGrid<GlobalTransform>(0.0f), Exception);
+}
+
+/**
+ * @brief Tests that restoring a world after its grid was removed or re-added only touches the live grid.
+ */
+TEST(SpatialTest, ReplaceAndRemoveGrid) {
+    World world;
+    world.addComponent<Transform>(world.createEntity(), Transform{});
+    world.addSpatialGrid(1.0f);
+    const std::vector<iodine::byte> snapshot = world.saveSnapshot();
+
+    world.removeResource<Spatial::Grid<Transform>>();
+    Spatial::Grid<Transform>& replaced = world.addSpatialGrid(2.0f);
+    replaced.update();
+    world.loadSnapshot(snapshot);
+    replaced.update();
+    EXPECT_EQ(replaced.getSize(), 1u);
+    EXPECT_EQ(replaced.getCellSize(), 2.0f);
+
+    World other;
+    world.removeResource<Spatial::Grid<Transform>>();
+    world.loadSnapshot(snapshot);
+    world.copyFrom(other);
+    EXPECT_EQ(world.findResource<Spatial::Grid<Transform>>(), nullptr);
+}
@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Accel {
+    float value;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Accel, "Accel", Fields().with("value", &Accel::value));
+
+struct Drag {
+    float value;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Drag, "Drag", Fields().with("value", &Drag::value));
+
+static System::Function noop() {
+    return [](World&, iodine::f64) {};
+}
+
+/**
+ * @brief Tests that readers share a stage and writers are split from readers of the same component.
+ */
+TEST(SchedulerTest, ConflictsSplitStages) {
+    World world;
+    world.addSystem(world.system("readA").reads<Accel>().build(noop()));
+    world.addSystem(world.system("readA2").reads<Accel>().build(noop()));
+    world.addSystem(world.system("writeA").writes<Accel>().build(noop()));
+    world.addSystem(world.system("writeD").writes<Drag>().build(noop()));
+
+    const auto& stages = world.getScheduler().getStages();
+    ASSERT_EQ(stages.size(), 2u);
+    EXPECT_EQ(stages[0], (std::vector<iodine::u64>{0, 1, 3}));
+    EXPECT_EQ(stages[1], (std::vector<iodine::u64>{2}));
+}
+
+/**
+ * @brief Tests explicit ordering, sync points and cycle detection.
+ */
+TEST(SchedulerTest, OrderingAndSyncPoints) {
+    World world;
+    world.addSystem(world.system("late").reads<Drag>().after("early").build(noop()));
+    world.addSystem(world.system("early").reads<Accel>().build(noop()));
+    world.addSyncPoint();
+    world.addSystem(world.system("independent").reads<Accel>().build(noop()));
+
+    const auto& stages = world.getScheduler().getStages();
+    ASSERT_EQ(stages.size(), 3u);
+    EXPECT_EQ(stages[0], (std::vector<iodine::u64>{1}));
+    EXPECT_EQ(stages[1], (std::vector<iodine::u64>{0}));
+    EXPECT_EQ(stages[2], (std::vector<iodine::u64>{2}));
+
+    World cyclic;
+    cyclic.addSystem(cyclic.system("a").after("b").build(noop()));
+    cyclic.addSystem(cyclic.system("b").after("a").build(noop()));
+    EXPECT_THROW(cyclic.getScheduler().getStages(), Exception);
+}
+
+/**
+ * @brief Tests that update runs every system once on a thread pool.
+ */
+TEST(SchedulerTest, UpdateRunsSystems) {
+    World world;
+    ThreadPool pool(2);
+    world.setThreadPool(&pool);
+
+    std::atomic<int> runs{0};
+    for (int i = 0; i < 8; i++) {
+        world.addSystem(world.system("system" + std::to_string(i)).reads<Accel>().build([&](World&, iodine::f64) { runs++; }));
+    }
+    world.update(1.0 / 60.0);
+    world.update(1.0 / 60.0);
+    EXPECT_EQ(runs.load(), 16);
+}
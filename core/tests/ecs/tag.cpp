@@ -0,0 +1,92 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Frozen {
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Frozen, "Frozen");
+
+struct Charge {
+    float amount;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Charge, "Charge", Fields().with("amount", &Charge::amount));
+
+/**
+ * @brief Tests that tag pools keep membership without storing values.
+ */
+TEST(TagTest, MembershipOnly) {
+    SparseSet<Frozen> set;
+    set.insert(4, Frozen{});
+    set.insert(9, Frozen{});
+    set.erase(4);
+    EXPECT_FALSE(set.contains(4));
+    EXPECT_TRUE(set.contains(9));
+    EXPECT_EQ(set.getSize(), 1u);
+    EXPECT_LT(sizeof(SparseSet<Frozen>), sizeof(SparseSet<Charge>));
+}
+
+class TagTest : public ::testing::TestWithParam<Component::Mode> {};
+
+/**
+ * @brief Tests that tags listed in a view filter entities without being passed to the function.
+ */
+TEST_P(TagTest, TagsAsFilters) {
+    World world(GetParam());
+    for (int i = 0; i < 10; i++) {
+        Entity entity = world.createEntity();
+        world.addComponent<Charge>(entity, static_cast<float>(i));
+        if (i % 2 == 0) world.addComponent<Frozen>(entity);
+    }
+
+    float total = 0.0f;
+    int count = 0;
+    world.view<Charge, Frozen>().each([&](Charge& charge) {
+        total += charge.amount;
+        count++;
+    });
+    EXPECT_EQ(count, 5);
+    EXPECT_FLOAT_EQ(total, 20.0f);
+
+    count = 0;
+    world.view<const Charge, With<Frozen>>().each([&](Entity entity, const Charge&) {
+        EXPECT_TRUE(world.hasComponent<Frozen>(entity));
+        count++;
+    });
+    EXPECT_EQ(count, 5);
+}
+
+/**
+ * @brief Tests that a rare tag drives the iteration and that views made only of tags work.
+ */
+TEST_P(TagTest, TagDrivesIteration) {
+    World world(GetParam());
+    for (int i = 0; i < 100; i++) {
+        Entity entity = world.createEntity();
+        world.addComponent<Charge>(entity, 1.0f);
+        if (i % 25 == 0) world.addComponent<Frozen>(entity);
+    }
+
+    auto view = world.view<Charge, With<Frozen>>();
+    if (GetParam() == Component::Mode::Sparse) EXPECT_EQ(view.sizeHint(), 4u);
+    int count = 0;
+    view.each([&](Entity entity, Charge&) {
+        EXPECT_TRUE(world.hasComponent<Frozen>(entity));
+        count++;
+    });
+    EXPECT_EQ(count, 4);
+
+    count = 0;
+    world.view<Frozen>().each([&](Entity entity) {
+        EXPECT_TRUE(world.hasComponent<Frozen>(entity));
+        count++;
+    });
+    EXPECT_EQ(count, 4);
+}
+
+INSTANTIATE_TEST_SUITE_P(StorageModes, TagTest, ::testing::Values(Component::Mode::Sparse, Component::Mode::Archetype));
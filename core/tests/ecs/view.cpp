@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+
+#include "ecs/world.hpp"
+#include "reflection/traits/field.hpp"
+
+using namespace iodine::core;
+
+struct Mass {
+    float kg;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Mass, "Mass", Fields().with("kg", &Mass::kg));
+
+struct Speed {
+    float value;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Speed, "Speed", Fields().with("value", &Speed::value));
+
+struct Spark {
+    float heat;
+
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Spark, "Spark", Fields().with("heat", &Spark::heat));
+
+template <>
+inline constexpr iodine::b8 Component::Chunked<Spark> = true;
+
+struct Dead {
+    IO_REFLECT;
+};
+IO_REFLECT_IMPL(Dead, "Dead");
+
+/**
+ * @brief Populates a world where every entity has Mass and every third one also has Speed.
+ */
+static std::vector<Entity> populate(World& world) {
+    std::vector<Entity> spawned;
+    for (int i = 0; i < 30; i++) {
+        Entity e = world.createEntity();
+        world.addComponent<Mass>(e, static_cast<float>(i));
+        if (i % 3 == 0) world.addComponent<Speed>(e, 1.0f);
+        spawned.push_back(e);
+    }
+    return spawned;
+}
+
+class ViewTest : public ::testing::TestWithParam<Component::Mode> {};
+
+/**
+ * @brief Tests that each() visits exactly the entities holding every viewed component.
+ */
+TEST_P(ViewTest, EachVisitsJoin) {
+    World world(GetParam());
+    std::vector<Entity> spawned = populate(world);
+
+    int visited = 0;
+    world.view<Mass, Speed>().each([&](Entity entity, Mass& mass, Speed& speed) {
+        EXPECT_TRUE(world.hasComponent<Speed>(entity));
+        speed.value += mass.kg;
+        visited++;
+    });
+    EXPECT_EQ(visited, 10);
+    EXPECT_FLOAT_EQ(world.getComponent<Speed>(spawned[3]).value, 4.0f);
+}
+
+/**
+ * @brief Tests range-for iteration with structured bindings and read-only components.
+ */
+TEST_P(ViewTest, RangeFor) {
+    World world(GetParam());
+    populate(world);
+
+    float total = 0.0f;
+    int visited = 0;
+    for (auto [entity, mass, speed] : world.view<const Mass, Speed>()) {
+        total += mass.kg;
+        visited++;
+    }
+    EXPECT_EQ(visited, 10);
+    EXPECT_FLOAT_EQ(total, 135.0f);  // 0 + 3 + ... + 27
+
+    int all = 0;
+    world.view<Mass>().each([&](const Mass&) { all++; });
+    EXPECT_EQ(all, 30);
+}
+
+/**
+ * @brief Tests that Without<T> skips entities holding T, whether it is a tag or a component.
+ */
+TEST_P(ViewTest, WithoutExcludes) {
+    World world(GetParam());
+    std::vector<Entity> spawned = populate(world);
+    for (int i = 0; i < 30; i += 2) world.addComponent<Dead>(spawned[i]);
+
+    int alive = 0;
+    world.view<Mass, Without<Dead>>().each([&](Entity entity, Mass&) {
+        EXPECT_FALSE(world.hasComponent<Dead>(entity));
+        alive++;
+    });
+    EXPECT_EQ(alive, 15);
+
+    int slow = 0;
+    for (auto [entity, mass] : world.view<const Mass, Without<Speed>, Without<Dead>>()) {
+        EXPECT_FALSE(world.hasComponent<Speed>(entity));
+        slow++;
+    }
+    EXPECT_EQ(slow, 10);  // Odd indices not divisible by 3.
+}
+
+/**
+ * @brief Tests that Optional<T> passes a pointer that is null exactly for entities without T.
+ */
+TEST_P(ViewTest, OptionalPassesPointer) {
+    World world(GetParam());
+    std::vector<Entity> spawned = populate(world);
+
+    int visited = 0;
+    int present = 0;
+    world.view<const Mass, Optional<Speed>>().each([&](Entity entity, const Mass& mass, Speed* speed) {
+        EXPECT_EQ(speed != nullptr, world.hasComponent<Speed>(entity));
+        if (speed) {
+            speed->value = mass.kg;
+            present++;
+        }
+        visited++;
+    });
+    EXPECT_EQ(visited, 30);
+    EXPECT_EQ(present, 10);
+    EXPECT_FLOAT_EQ(world.getComponent<Speed>(spawned[9]).value, 9.0f);
+
+    int reads = 0;
+    for (auto [entity, mass, speed] : world.view<Mass, Optional<const Speed>, Without<Dead>>()) {
+        static_assert(std::is_same_v<decltype(speed), const Speed*>);
+        if (speed) reads++;
+    }
+    EXPECT_EQ(reads, 10);
+}
+
+INSTANTIATE_TEST_SUITE_P(StorageModes, ViewTest, ::testing::Values(Component::Mode::Sparse, Component::Mode::Archetype));
+
+/**
+ * @brief Tests that parallel iteration visits every match once and reports chunk timings.
+ */
+TEST_P(ViewTest, ForEachParallel) {
+    World world(GetParam());
+    for (int i = 0; i < 5000; i++) {
+        Entity e = world.createEntity();
+        world.addComponent<Mass>(e, 1.0f);
+        world.addComponent<Speed>(e, 0.0f);
+    }
+
+    ThreadPool pool(3);
+    const std::string label = GetParam() == Component::Mode::Sparse ? "view.sparse" : "view.archetype";
+    world.view<const Mass, Speed>().forEachParallel(pool, [](const Mass& mass, Speed& speed) { speed.value += mass.kg; }, 100, label.c_str());
+
+    float total = 0.0f;
+    world.view<Speed>().each([&](Speed& speed) { total += speed.value; });
+    EXPECT_FLOAT_EQ(total, 5000.0f);
+    EXPECT_GT(Metrics::getInstance().getTiming(label).count, 1u);
+}
+
+/**
+ * @brief Tests views, parallel iteration and snapshots over a chunked pool filled in one burst.
+ */
+TEST(ChunkedViewTest, ChunkedPool) {
+    World world;
+    constexpr iodine::u64 Count = 10000;
+    std::vector<Entity> spawned;
+    for (iodine::u64 i = 0; i < Count; i++) spawned.push_back(world.createEntity());
+    world.addComponents<Spark>(spawned, Spark{1.0f});
+    const Spark* first = &world.getComponent<Spark>(spawned[0]);
+    for (iodine::u64 i = 0; i < 100; i++) world.addComponent<Spark>(world.createEntity(), 1.0f);
+    EXPECT_EQ(&world.getComponent<Spark>(spawned[0]), first);
+
+    ThreadPool pool(3);
+    world.view<Spark>().forEachParallel(pool, [](Spark& spark) { spark.heat *= 2.0f; }, 100);
+    float total = 0.0f;
+    world.view<const Spark>().each([&](const Spark& spark) { total += spark.heat; });
+    EXPECT_FLOAT_EQ(total, 2.0f * (Count + 100));
+
+    const std::vector<iodine::byte> snapshot = world.saveSnapshot();
+    world.destroyEntity(spawned[5]);
+    world.loadSnapshot(snapshot);
+    EXPECT_FLOAT_EQ(world.getComponent<Spark>(spawned[5]).heat, 2.0f);
+}